@@ -0,0 +1,94 @@
+/******************************************************************************
+* Copyright (C) 2017 by Ben Heberlein
+*
+* Redistribution, modification or use of this software in source or binary
+* forms is permitted as long as the files maintain this copyright. This file
+* was created for the University of Colorado Boulder course Advanced Practical
+* Embedded Software Development. Ben Heberlein and the University of Colorado 
+* are not liable for any misuse of this material.
+*
+*******************************************************************************/
+/**
+ * @file bench_circbuf.c
+ * @brief Throughput benchmark for the circbuf modes
+ * 
+ * This file measures add/remove operations per second for the default pointer
+ * mode and the CIRCBUF_POW2 index mode of circbuf_t. Each round fills the
+ * buffer completely and then drains it, so every add and remove crosses the
+ * wrap point at some stage.
+ *
+ * @author Ben Heberlein
+ * @date October 17 2026
+ * @version 1.0
+ *
+ */
+
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+#include "circbuf.h"
+
+#define BENCH_OPS 20000000UL
+
+/**
+ * @brief Returns a monotonic timestamp in seconds
+ *
+ * @return The current time in seconds
+ */
+static double bench_now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/**
+ * @brief Runs fill/drain rounds on one buffer and prints ops/sec
+ *
+ * @param name The label to print for this mode
+ * @param capacity The buffer capacity
+ * @param flags The circbuf_allocate_ex flags
+ */
+static void bench_mode(const char *name, circbuf_count_t capacity, uint32_t flags) {
+    circbuf_t *cb = NULL;
+    uint32_t data = 0;
+    uint32_t sum = 0;
+
+    if (circbuf_allocate_ex(capacity, flags, &cb) != ERR_SUCCESS) {
+        printf("Could not allocate %s buffer\n", name);
+        return;
+    }
+
+    unsigned long rounds = BENCH_OPS / (2UL * capacity);
+    double start = bench_now();
+
+    for (unsigned long r = 0; r < rounds; r++) {
+        for (circbuf_count_t i = 0; i < capacity; i++) {
+            circbuf_add(i, cb);
+        }
+        for (circbuf_count_t i = 0; i < capacity; i++) {
+            circbuf_remove(&data, cb);
+            sum += data;
+        }
+    }
+
+    double elapsed = bench_now() - start;
+    double ops = 2.0 * rounds * capacity;
+
+    printf("%-8s capacity %7lu: %8.1f Mops/s (checksum %u)\n",
+           name, (unsigned long) capacity, ops / elapsed / 1e6, sum);
+
+    circbuf_destroy(cb);
+}
+
+int main() {
+    circbuf_count_t capacities[] = {16, 256, 1024, 1UL << 22};
+
+    for (unsigned i = 0; i < sizeof(capacities) / sizeof(capacities[0]); i++) {
+        bench_mode("pointer", capacities[i], 0);
+        bench_mode("pow2", capacities[i], CIRCBUF_POW2);
+    }
+
+    return 0;
+}
@@ -0,0 +1,193 @@
+/******************************************************************************
+* Copyright (C) 2017 by Ben Heberlein
+*
+* Redistribution, modification or use of this software in source or binary
+* forms is permitted as long as the files maintain this copyright. This file
+* was created for the University of Colorado Boulder course Advanced Practical
+* Embedded Software Development. Ben Heberlein and the University of Colorado
+* are not liable for any misuse of this material.
+*
+*******************************************************************************/
+/**
+ * @file bench_find.c
+ * @brief Throughput benchmark for the search kernels
+ *
+ * This file measures how many items per second a full scan for a missing
+ * value looks at. It compares a plain loop with simd_find_eq on arrays that
+ * fit in L1, L2 and main memory, and then runs the same search through
+ * circbuf_find on a wrapped buffer, ll2u_search on an unrolled list and
+ * ll2_list_search on a plain list. The compact line compares the plain list
+ * with ll2a_search on the array backed list.
+ *
+ * @author Ben Heberlein
+ * @date October 17 2026
+ * @version 1.0
+ *
+ */
+
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "circbuf.h"
+#include "ll2.h"
+#include "ll2u.h"
+#include "ll2a.h"
+#include "simd_find.h"
+
+#define BENCH_ITEMS_SCANNED 400000000UL
+#define BENCH_MISSING 0xffffffffu
+
+/**
+ * @brief Returns a monotonic timestamp in seconds
+ *
+ * @return The current time in seconds
+ */
+static double bench_now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/**
+ * @brief The loop simd_find_eq replaces, kept out of line so it is not folded
+ *
+ * @param data Start of the run
+ * @param count Number of items
+ * @param value Value to look for
+ *
+ * @return Index of the first match, or count
+ */
+__attribute__((noinline))
+static size_t bench_scalar_find(const uint32_t *data, size_t count, uint32_t value) {
+    for (size_t i = 0; i < count; i++) {
+        if (data[i] == value) {
+            return i;
+        }
+    }
+    return count;
+}
+
+/**
+ * @brief Scans an array for a missing value many times with both searches
+ *
+ * @param data The array to scan
+ * @param count The number of items in the array
+ */
+static void bench_array(const uint32_t *data, size_t count) {
+    unsigned long rounds = BENCH_ITEMS_SCANNED / count;
+    volatile size_t sink = 0;
+
+    double start = bench_now();
+    for (unsigned long r = 0; r < rounds; r++) {
+        sink += bench_scalar_find(data, count, BENCH_MISSING);
+    }
+    double scalar = bench_now() - start;
+
+    start = bench_now();
+    for (unsigned long r = 0; r < rounds; r++) {
+        sink += simd_find_eq(data, count, BENCH_MISSING);
+    }
+    double simd = bench_now() - start;
+
+    printf("array %9zu %14.0f %14.0f %8.1fx\n", count,
+           rounds * count / scalar / 1e6, rounds * count / simd / 1e6, scalar / simd);
+}
+
+int main(void) {
+    static const size_t sizes[] = { 64, 1024, 16384, 1UL << 22 };
+    size_t max = sizes[sizeof(sizes) / sizeof(sizes[0]) - 1];
+    volatile size_t sink = 0;
+
+    uint32_t *data = (uint32_t *) malloc(max * sizeof(uint32_t));
+    if (data == NULL) {
+        printf("Could not allocate array\n");
+        return 1;
+    }
+    for (size_t i = 0; i < max; i++) {
+        data[i] = (uint32_t) i;
+    }
+
+    printf("kernels: %s\n", simd_find_impl());
+    printf("search      items   scalar Mit/s     simd Mit/s  speedup\n");
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+        bench_array(data, sizes[s]);
+    }
+    free(data);
+
+    /* Wrapped ring, so both runs get scanned */
+    circbuf_t *cb = NULL;
+    circbuf_count_t at;
+    uint32_t temp;
+    size_t ring = 1UL << 16;
+
+    if (circbuf_allocate_ex(ring, CIRCBUF_POW2, &cb) == ERR_SUCCESS) {
+        for (size_t i = 0; i < ring; i++) {
+            circbuf_add((uint32_t) i, cb);
+        }
+        for (size_t i = 0; i < ring / 2; i++) {
+            circbuf_remove(&temp, cb);
+            circbuf_add((uint32_t) i, cb);
+        }
+
+        unsigned long rounds = BENCH_ITEMS_SCANNED / ring;
+        double start = bench_now();
+        for (unsigned long r = 0; r < rounds; r++) {
+            sink += circbuf_find(BENCH_MISSING, &at, cb);
+        }
+        double elapsed = bench_now() - start;
+        printf("circbuf %7zu %14s %14.0f\n", ring, "-", rounds * ring / elapsed / 1e6);
+        circbuf_destroy(cb);
+    }
+
+    /* Lists of the same length, one value per node against blocks */
+    ll2u_list_t unrolled;
+    ll2_list_t plain;
+    size_t list = 1UL << 16;
+    size_t index;
+
+    ll2u_init(&unrolled);
+    ll2_list_init(&plain, NULL);
+    for (size_t i = 0; i < list; i++) {
+        ll2u_add(&unrolled, (uint32_t) i, i);
+        ll2_list_push_back(&plain, (uint32_t) i);
+    }
+
+    unsigned long rounds = BENCH_ITEMS_SCANNED / list / 8;
+    double start = bench_now();
+    for (unsigned long r = 0; r < rounds; r++) {
+        sink += ll2_list_search(&plain, BENCH_MISSING, &index);
+    }
+    double scalar = bench_now() - start;
+
+    start = bench_now();
+    for (unsigned long r = 0; r < rounds; r++) {
+        sink += ll2u_search(&unrolled, BENCH_MISSING, &index);
+    }
+    double simd = bench_now() - start;
+    printf("list %10zu %14.0f %14.0f %8.1fx\n", list,
+           rounds * list / scalar / 1e6, rounds * list / simd / 1e6, scalar / simd);
+
+    /* Same list with 12 byte nodes in one array */
+    ll2a_list_t compact;
+    ll2a_init(&compact, list);
+    for (size_t i = 0; i < list; i++) {
+        ll2a_push_back(&compact, (uint32_t) i);
+    }
+
+    start = bench_now();
+    for (unsigned long r = 0; r < rounds; r++) {
+        sink += ll2a_search(&compact, BENCH_MISSING, &index);
+    }
+    double compacted = bench_now() - start;
+    printf("compact %7zu %14.0f %14.0f %8.1fx\n", list,
+           rounds * list / scalar / 1e6, rounds * list / compacted / 1e6, scalar / compacted);
+
+    ll2a_destroy(&compact);
+    ll2u_destroy(&unrolled);
+    ll2_list_destroy(&plain);
+    (void) sink;
+    return 0;
+}
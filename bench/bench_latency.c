@@ -0,0 +1,370 @@
+/******************************************************************************
+* Copyright (C) 2017 by Ben Heberlein
+*
+* Redistribution, modification or use of this software in source or binary
+* forms is permitted as long as the files maintain this copyright. This file
+* was created for the University of Colorado Boulder course Advanced Practical
+* Embedded Software Development. Ben Heberlein and the University of Colorado
+* are not liable for any misuse of this material.
+*
+*******************************************************************************/
+/**
+ * @file bench_latency.c
+ * @brief Latency and throughput benchmark for circbuf and the ll2 head API
+ *
+ * This file times every call of circbuf_add, circbuf_remove, ll2_add_node,
+ * ll2_remove_node, ll2_search and ll2_size on its own, across sizes and
+ * access patterns, and reports throughput with p50, p99 and p999 latency.
+ * The cost of reading the clock is measured first and taken off each sample,
+ * and throughput is the number of calls over the sum of their samples.
+ *
+ * Results go to stdout as a table. If the BENCH_CSV environment variable
+ * names a file, they are also written there as CSV with a header row, along
+ * with the optimization level the benchmark was built with, so runs can be
+ * compared over time.
+ *
+ * @author Ben Heberlein
+ * @date October 17 2026
+ * @version 1.0
+ *
+ */
+
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "circbuf.h"
+#include "ll2.h"
+
+#ifndef BENCH_OPT_NAME
+#define BENCH_OPT_NAME "unknown"
+#endif
+
+#define BENCH_MAX_SAMPLES 200000
+#define BENCH_TIMER_ROUNDS 10000
+#define BENCH_SEARCH_OPS 2000
+
+/**
+ * @brief Where results go and the sample buffer they are built from
+ */
+typedef struct bench_out_s {
+    FILE *csv;
+    uint64_t timer_ns;
+    uint64_t samples[BENCH_MAX_SAMPLES];
+    size_t count;
+} bench_out_t;
+
+/**
+ * @brief Returns a monotonic timestamp in nanoseconds
+ *
+ * @return The current time in nanoseconds
+ */
+static inline uint64_t bench_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000000000u + (uint64_t) ts.tv_nsec;
+}
+
+/**
+ * @brief Small generator so every run sees the same indices
+ *
+ * @param state The generator state
+ *
+ * @return The next random value
+ */
+static uint64_t bench_rand(uint64_t *state) {
+    uint64_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    *state = x;
+    return x;
+}
+
+/**
+ * @brief Stores one sample with the clock overhead taken off
+ *
+ * @param out The results
+ * @param start Timestamp before the call
+ * @param end Timestamp after the call
+ */
+static inline void bench_sample(bench_out_t *out, uint64_t start, uint64_t end) {
+    uint64_t ns = end - start;
+
+    if (out->count < BENCH_MAX_SAMPLES) {
+        out->samples[out->count++] = (ns > out->timer_ns) ? ns - out->timer_ns : 0;
+    }
+}
+
+/**
+ * @brief Sort order for samples
+ *
+ * @param a The first sample
+ * @param b The second sample
+ *
+ * @return Negative, zero or positive as a is below, equal to or above b
+ */
+static int bench_compare(const void *a, const void *b) {
+    uint64_t x = *(const uint64_t *) a;
+    uint64_t y = *(const uint64_t *) b;
+
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief Returns a percentile of sorted samples
+ *
+ * @param samples The sorted samples
+ * @param count The number of samples, at least 1
+ * @param fraction The percentile as a fraction, such as 0.99
+ *
+ * @return The sample at that percentile
+ */
+static uint64_t bench_percentile(const uint64_t *samples, size_t count, double fraction) {
+    size_t i = (size_t) (fraction * count);
+
+    return samples[(i < count) ? i : count - 1];
+}
+
+/**
+ * @brief Reports the samples gathered for one case and clears them
+ *
+ * @param out The results
+ * @param op The function that was timed
+ * @param pattern The access pattern
+ * @param size The size of the buffer or list
+ */
+static void bench_report(bench_out_t *out, const char *op, const char *pattern, size_t size) {
+    if (out->count == 0) {
+        return;
+    }
+
+    uint64_t total = 0;
+    for (size_t i = 0; i < out->count; i++) {
+        total += out->samples[i];
+    }
+    qsort(out->samples, out->count, sizeof(uint64_t), bench_compare);
+
+    double ops = (total > 0) ? out->count * 1e9 / total : 0.0;
+    uint64_t p50 = bench_percentile(out->samples, out->count, 0.50);
+    uint64_t p99 = bench_percentile(out->samples, out->count, 0.99);
+    uint64_t p999 = bench_percentile(out->samples, out->count, 0.999);
+
+    printf("%-16s %-10s %7zu %8zu %14.0f %8llu %8llu %8llu\n", op, pattern, size, out->count, ops,
+           (unsigned long long) p50, (unsigned long long) p99, (unsigned long long) p999);
+    if (out->csv != NULL) {
+        fprintf(out->csv, "%s,%s,%s,%zu,%zu,%.0f,%llu,%llu,%llu\n", BENCH_OPT_NAME, op, pattern, size,
+                out->count, ops, (unsigned long long) p50, (unsigned long long) p99,
+                (unsigned long long) p999);
+    }
+
+    out->count = 0;
+}
+
+/**
+ * @brief Measures the smallest cost of reading the clock twice
+ *
+ * @return The overhead in nanoseconds
+ */
+static uint64_t bench_timer_overhead(void) {
+    uint64_t best = UINT64_MAX;
+
+    for (int i = 0; i < BENCH_TIMER_ROUNDS; i++) {
+        uint64_t start = bench_ns();
+        uint64_t end = bench_ns();
+        if (end - start < best) {
+            best = end - start;
+        }
+    }
+
+    return best;
+}
+
+/**
+ * @brief Times circbuf_add and circbuf_remove on one buffer size
+ *
+ * The fill pattern adds until full and then removes until empty. The steady
+ * pattern keeps the buffer half full and alternates the two calls.
+ *
+ * @param out The results
+ * @param capacity The buffer size
+ */
+static void bench_circbuf(bench_out_t *out, size_t capacity) {
+    circbuf_t *cb = NULL;
+    uint32_t data;
+    uint64_t start;
+    size_t rounds = BENCH_MAX_SAMPLES / capacity;
+
+    if (circbuf_allocate((circbuf_count_t) capacity, &cb) != ERR_SUCCESS) {
+        return;
+    }
+    if (rounds == 0) {
+        rounds = 1;
+    }
+
+    for (size_t r = 0; r < rounds; r++) {
+        for (size_t i = 0; i < capacity; i++) {
+            start = bench_ns();
+            circbuf_add((uint32_t) i, cb);
+            bench_sample(out, start, bench_ns());
+        }
+        for (size_t i = 0; i < capacity; i++) {
+            circbuf_remove(&data, cb);
+        }
+    }
+    bench_report(out, "circbuf_add", "fill", capacity);
+
+    for (size_t r = 0; r < rounds; r++) {
+        for (size_t i = 0; i < capacity; i++) {
+            circbuf_add((uint32_t) i, cb);
+        }
+        for (size_t i = 0; i < capacity; i++) {
+            start = bench_ns();
+            circbuf_remove(&data, cb);
+            bench_sample(out, start, bench_ns());
+        }
+    }
+    bench_report(out, "circbuf_remove", "drain", capacity);
+
+    for (size_t i = 0; i < capacity / 2; i++) {
+        circbuf_add((uint32_t) i, cb);
+    }
+    for (size_t i = 0; i < BENCH_MAX_SAMPLES / 2; i++) {
+        start = bench_ns();
+        circbuf_add((uint32_t) i, cb);
+        bench_sample(out, start, bench_ns());
+        circbuf_remove(&data, cb);
+    }
+    bench_report(out, "circbuf_add", "steady", capacity);
+    for (size_t i = 0; i < BENCH_MAX_SAMPLES / 2; i++) {
+        circbuf_add((uint32_t) i, cb);
+        start = bench_ns();
+        circbuf_remove(&data, cb);
+        bench_sample(out, start, bench_ns());
+    }
+    bench_report(out, "circbuf_remove", "steady", capacity);
+
+    circbuf_destroy(cb);
+}
+
+/**
+ * @brief Picks the index for an access pattern
+ *
+ * @param pattern 0 for the head, 1 for the tail, 2 for random
+ * @param length The number of valid positions
+ * @param seed The generator state for the random pattern
+ *
+ * @return The index to use
+ */
+static uint16_t bench_index(int pattern, size_t length, uint64_t *seed) {
+    if (pattern == 0 || length == 0) {
+        return 0;
+    }
+    if (pattern == 1) {
+        return (uint16_t) (length - 1);
+    }
+    return (uint16_t) (bench_rand(seed) % length);
+}
+
+/**
+ * @brief Times the ll2 head API on one list size
+ *
+ * ll2_add_node builds a list of size nodes at the head, at the tail or at
+ * random, and ll2_remove_node takes it apart again the same way.
+ * ll2_search looks for values that are there and ones that are not, and
+ * ll2_size counts the full list.
+ *
+ * @param out The results
+ * @param size The number of nodes, at most 65535
+ */
+static void bench_ll2(bench_out_t *out, size_t size) {
+    static const char *patterns[] = { "head", "tail", "random" };
+    ll2_node_t *head = NULL;
+    uint64_t seed = 88172645463325252ULL;
+    uint64_t start;
+    uint16_t index;
+    volatile uint16_t sink;
+
+    for (int p = 0; p < 3; p++) {
+        for (size_t i = 0; i < size; i++) {
+            /* Adding at the tail means at index i, one past the last node */
+            uint16_t at = (p == 1) ? (uint16_t) i : bench_index(p, i + 1, &seed);
+            start = bench_ns();
+            ll2_add_node(&head, (uint32_t) i, at);
+            bench_sample(out, start, bench_ns());
+        }
+        bench_report(out, "ll2_add_node", patterns[p], size);
+
+        for (size_t i = size; i > 0; i--) {
+            uint16_t at = bench_index(p, i, &seed);
+            start = bench_ns();
+            ll2_remove_node(&head, at);
+            bench_sample(out, start, bench_ns());
+        }
+        bench_report(out, "ll2_remove_node", patterns[p], size);
+    }
+
+    for (size_t i = 0; i < size; i++) {
+        ll2_add_node(&head, (uint32_t) i, 0);
+    }
+    for (size_t i = 0; i < BENCH_SEARCH_OPS; i++) {
+        uint32_t value = (uint32_t) (bench_rand(&seed) % size);
+        start = bench_ns();
+        ll2_search(&head, value, &index);
+        bench_sample(out, start, bench_ns());
+    }
+    bench_report(out, "ll2_search", "hit", size);
+    for (size_t i = 0; i < BENCH_SEARCH_OPS; i++) {
+        start = bench_ns();
+        ll2_search(&head, (uint32_t) size, &index);
+        bench_sample(out, start, bench_ns());
+    }
+    bench_report(out, "ll2_search", "miss", size);
+    for (size_t i = 0; i < BENCH_SEARCH_OPS; i++) {
+        start = bench_ns();
+        sink = ll2_size(&head);
+        bench_sample(out, start, bench_ns());
+    }
+    bench_report(out, "ll2_size", "full", size);
+
+    (void) sink;
+    ll2_destroy(&head);
+}
+
+int main(void) {
+    static bench_out_t out;
+    static const size_t circbuf_sizes[] = { 64, 1024, 65536 };
+    static const size_t ll2_sizes[] = { 100, 1000, 10000 };
+    const char *path = getenv("BENCH_CSV");
+
+    out.count = 0;
+    out.csv = NULL;
+    if (path != NULL && path[0] != '\0') {
+        out.csv = fopen(path, "w");
+        if (out.csv == NULL) {
+            printf("Could not open %s\n", path);
+            return 1;
+        }
+        fprintf(out.csv, "opt,op,pattern,size,samples,ops_per_sec,p50_ns,p99_ns,p999_ns\n");
+    }
+    out.timer_ns = bench_timer_overhead();
+
+    printf("build %s, clock overhead %llu ns taken off each sample\n", BENCH_OPT_NAME,
+           (unsigned long long) out.timer_ns);
+    printf("%-16s %-10s %7s %8s %14s %8s %8s %8s\n", "op", "pattern", "size", "samples",
+           "ops/s", "p50 ns", "p99 ns", "p999 ns");
+    for (size_t s = 0; s < sizeof(circbuf_sizes) / sizeof(circbuf_sizes[0]); s++) {
+        bench_circbuf(&out, circbuf_sizes[s]);
+    }
+    for (size_t s = 0; s < sizeof(ll2_sizes) / sizeof(ll2_sizes[0]); s++) {
+        bench_ll2(&out, ll2_sizes[s]);
+    }
+
+    if (out.csv != NULL) {
+        fclose(out.csv);
+        printf("CSV written to %s\n", path);
+    }
+    return 0;
+}
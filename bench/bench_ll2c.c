@@ -0,0 +1,216 @@
+/******************************************************************************
+* Copyright (C) 2017 by Ben Heberlein
+*
+* Redistribution, modification or use of this software in source or binary
+* forms is permitted as long as the files maintain this copyright. This file
+* was created for the University of Colorado Boulder course Advanced Practical
+* Embedded Software Development. Ben Heberlein and the University of Colorado
+* are not liable for any misuse of this material.
+*
+*******************************************************************************/
+/**
+ * @file bench_ll2c.c
+ * @brief Thread scaling benchmark for the concurrent list
+ *
+ * This file measures the throughput of a read mostly load on ll2c_list_t
+ * against an ll2_list_t wrapped in a mutex, for 1 up to the number of online
+ * cores. Each operation is a search 90% of the time and otherwise an add or
+ * a remove at a random index, so the list keeps about the same length. An
+ * optional argument overrides the maximum thread count.
+ *
+ * @author Ben Heberlein
+ * @date October 17 2026
+ * @version 1.0
+ *
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include "ll2.h"
+#include "ll2c.h"
+
+#define BENCH_OPS_PER_THREAD 20000UL
+#define BENCH_LENGTH 1024
+#define BENCH_SEARCH_PERCENT 90
+
+/**
+ * @brief Shared state for one benchmark run
+ */
+typedef struct bench_ctx_s {
+    ll2c_list_t *concurrent;
+    ll2_list_t plain;
+    pthread_mutex_t lock;
+    _Atomic uint64_t seed;
+} bench_ctx_t;
+
+/**
+ * @brief Returns a monotonic timestamp in seconds
+ *
+ * @return The current time in seconds
+ */
+static double bench_now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/**
+ * @brief Small per thread generator
+ *
+ * @param state The generator state
+ *
+ * @return The next random value
+ */
+static uint64_t bench_rand(uint64_t *state) {
+    uint64_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    *state = x;
+    return x;
+}
+
+/**
+ * @brief Worker for the lock-free list
+ *
+ * @param arg The bench_ctx_t for this run
+ *
+ * @return Always NULL
+ */
+static void *bench_ll2c_worker(void *arg) {
+    bench_ctx_t *ctx = (bench_ctx_t *) arg;
+    uint64_t seed = atomic_fetch_add(&ctx->seed, 0x9e3779b97f4a7c15ULL);
+    ll2c_thread_t *self = ll2c_thread_register(ctx->concurrent);
+    size_t index;
+
+    if (self == NULL) {
+        return NULL;
+    }
+
+    for (unsigned long i = 0; i < BENCH_OPS_PER_THREAD; i++) {
+        uint64_t r = bench_rand(&seed);
+        unsigned op = r % 100;
+        size_t length = ll2c_size(ctx->concurrent);
+
+        if (op < BENCH_SEARCH_PERCENT) {
+            ll2c_search(ctx->concurrent, self, (uint32_t) (r >> 32) % (2 * BENCH_LENGTH), &index);
+        } else if (op % 2 == 0) {
+            ll2c_add(ctx->concurrent, self, (uint32_t) (r >> 32) % BENCH_LENGTH, (r >> 8) % (length + 1));
+        } else {
+            ll2c_remove(ctx->concurrent, self, (r >> 8) % (length + 1));
+        }
+    }
+
+    ll2c_thread_unregister(self);
+    return NULL;
+}
+
+/**
+ * @brief Worker for the mutex wrapped ll2_list_t baseline
+ *
+ * @param arg The bench_ctx_t for this run
+ *
+ * @return Always NULL
+ */
+static void *bench_mutex_worker(void *arg) {
+    bench_ctx_t *ctx = (bench_ctx_t *) arg;
+    uint64_t seed = atomic_fetch_add(&ctx->seed, 0x9e3779b97f4a7c15ULL);
+    size_t index;
+
+    for (unsigned long i = 0; i < BENCH_OPS_PER_THREAD; i++) {
+        uint64_t r = bench_rand(&seed);
+        unsigned op = r % 100;
+
+        pthread_mutex_lock(&ctx->lock);
+        size_t length = ll2_list_size(&ctx->plain);
+        if (op < BENCH_SEARCH_PERCENT) {
+            ll2_list_search(&ctx->plain, (uint32_t) (r >> 32) % (2 * BENCH_LENGTH), &index);
+        } else if (op % 2 == 0) {
+            ll2_list_add(&ctx->plain, (uint32_t) (r >> 32) % BENCH_LENGTH, (r >> 8) % (length + 1));
+        } else {
+            ll2_list_remove(&ctx->plain, (r >> 8) % (length + 1));
+        }
+        pthread_mutex_unlock(&ctx->lock);
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Runs one worker function on the given number of threads
+ *
+ * @param worker The thread function
+ * @param ctx The shared state
+ * @param threads The number of threads to start
+ *
+ * @return The total operations per second
+ */
+static double bench_run(void *(*worker)(void *), bench_ctx_t *ctx, long threads) {
+    pthread_t *tids = (pthread_t *) malloc(threads * sizeof(pthread_t));
+    if (tids == NULL) {
+        return 0.0;
+    }
+
+    double start = bench_now();
+    for (long t = 0; t < threads; t++) {
+        pthread_create(&tids[t], NULL, worker, ctx);
+    }
+    for (long t = 0; t < threads; t++) {
+        pthread_join(tids[t], NULL);
+    }
+    double elapsed = bench_now() - start;
+
+    free(tids);
+    return (double) BENCH_OPS_PER_THREAD * threads / elapsed;
+}
+
+int main(int argc, char **argv) {
+    bench_ctx_t ctx;
+    long max_threads = sysconf(_SC_NPROCESSORS_ONLN);
+
+    if (argc > 1) {
+        max_threads = atol(argv[1]);
+    }
+    if (max_threads < 1) {
+        max_threads = 1;
+    }
+    if (max_threads > LL2C_MAX_THREADS) {
+        max_threads = LL2C_MAX_THREADS;
+    }
+
+    /* The slot array is cache line aligned, so allocate it that way */
+    ctx.concurrent = (ll2c_list_t *) aligned_alloc(LL2C_CACHE_LINE, sizeof(ll2c_list_t));
+    if (ctx.concurrent == NULL || ll2c_init(ctx.concurrent) != LL2_SUCCESS ||
+        ll2_list_init(&ctx.plain, NULL) != LL2_SUCCESS) {
+        printf("Could not allocate lists\n");
+        return 1;
+    }
+    ll2c_thread_t *self = ll2c_thread_register(ctx.concurrent);
+    for (uint32_t i = 0; i < BENCH_LENGTH; i++) {
+        ll2c_add(ctx.concurrent, self, i, 0);
+        ll2_list_push_back(&ctx.plain, i);
+    }
+    ll2c_thread_unregister(self);
+    pthread_mutex_init(&ctx.lock, NULL);
+    atomic_init(&ctx.seed, 88172645463325252ULL);
+
+    printf("%d%% search, %d values\n", BENCH_SEARCH_PERCENT, BENCH_LENGTH);
+    printf("threads      ll2c Mops/s     mutex Mops/s\n");
+    for (long threads = 1; threads <= max_threads; threads++) {
+        double lockfree = bench_run(bench_ll2c_worker, &ctx, threads);
+        double locked = bench_run(bench_mutex_worker, &ctx, threads);
+        printf("%7ld %16.3f %16.3f\n", threads, lockfree / 1e6, locked / 1e6);
+    }
+
+    pthread_mutex_destroy(&ctx.lock);
+    ll2c_destroy(ctx.concurrent);
+    free(ctx.concurrent);
+    ll2_list_destroy(&ctx.plain);
+    return 0;
+}
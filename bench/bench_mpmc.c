@@ -0,0 +1,170 @@
+/******************************************************************************
+* Copyright (C) 2017 by Ben Heberlein
+*
+* Redistribution, modification or use of this software in source or binary
+* forms is permitted as long as the files maintain this copyright. This file
+* was created for the University of Colorado Boulder course Advanced Practical
+* Embedded Software Development. Ben Heberlein and the University of Colorado 
+* are not liable for any misuse of this material.
+*
+*******************************************************************************/
+/**
+ * @file bench_mpmc.c
+ * @brief Thread scaling benchmark for the multi producer, multi consumer buffer
+ * 
+ * This file measures the combined add/remove throughput of circbuf_mpmc_t
+ * against a circbuf_t wrapped in a mutex, for 1 up to the number of online
+ * cores. Every thread adds an item and then removes one, so all threads act
+ * as both producer and consumer. An optional argument overrides the maximum
+ * thread count.
+ *
+ * @author Ben Heberlein
+ * @date October 17 2026
+ * @version 1.0
+ *
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sched.h>
+#include "circbuf.h"
+#include "circbuf_mpmc.h"
+
+#define BENCH_OPS_PER_THREAD 2000000UL
+#define BENCH_CAPACITY 1024
+
+/**
+ * @brief Shared state for one benchmark run
+ */
+typedef struct bench_ctx_s {
+    circbuf_mpmc_t *queue;
+    circbuf_t *cb;
+    pthread_mutex_t lock;
+} bench_ctx_t;
+
+/**
+ * @brief Returns a monotonic timestamp in seconds
+ *
+ * @return The current time in seconds
+ */
+static double bench_now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/**
+ * @brief Worker for the lock-free buffer
+ *
+ * @param arg The bench_ctx_t for this run
+ *
+ * @return Always NULL
+ */
+static void *bench_mpmc_worker(void *arg) {
+    bench_ctx_t *ctx = (bench_ctx_t *) arg;
+    uint32_t data;
+
+    for (uint32_t i = 0; i < BENCH_OPS_PER_THREAD; i++) {
+        while (circbuf_mpmc_add(i, ctx->queue) != ERR_SUCCESS) {
+            sched_yield();
+        }
+        while (circbuf_mpmc_remove(&data, ctx->queue) != ERR_SUCCESS) {
+            sched_yield();
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Worker for the mutex wrapped circbuf_t baseline
+ *
+ * @param arg The bench_ctx_t for this run
+ *
+ * @return Always NULL
+ */
+static void *bench_mutex_worker(void *arg) {
+    bench_ctx_t *ctx = (bench_ctx_t *) arg;
+    circbuf_err_t err;
+    uint32_t data;
+
+    for (uint32_t i = 0; i < BENCH_OPS_PER_THREAD; i++) {
+        do {
+            pthread_mutex_lock(&ctx->lock);
+            err = circbuf_add(i, ctx->cb);
+            pthread_mutex_unlock(&ctx->lock);
+        } while (err != ERR_SUCCESS);
+        do {
+            pthread_mutex_lock(&ctx->lock);
+            err = circbuf_remove(&data, ctx->cb);
+            pthread_mutex_unlock(&ctx->lock);
+        } while (err != ERR_SUCCESS);
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Runs one worker function on the given number of threads
+ *
+ * @param worker The thread function
+ * @param ctx The shared state
+ * @param threads The number of threads to start
+ *
+ * @return The total operations per second
+ */
+static double bench_run(void *(*worker)(void *), bench_ctx_t *ctx, long threads) {
+    pthread_t *tids = (pthread_t *) malloc(threads * sizeof(pthread_t));
+    if (tids == NULL) {
+        return 0.0;
+    }
+
+    double start = bench_now();
+    for (long t = 0; t < threads; t++) {
+        pthread_create(&tids[t], NULL, worker, ctx);
+    }
+    for (long t = 0; t < threads; t++) {
+        pthread_join(tids[t], NULL);
+    }
+    double elapsed = bench_now() - start;
+
+    free(tids);
+    return 2.0 * BENCH_OPS_PER_THREAD * threads / elapsed;
+}
+
+int main(int argc, char **argv) {
+    bench_ctx_t ctx;
+    long max_threads = sysconf(_SC_NPROCESSORS_ONLN);
+
+    if (argc > 1) {
+        max_threads = atol(argv[1]);
+    }
+    if (max_threads < 1) {
+        max_threads = 1;
+    }
+
+    if (circbuf_mpmc_allocate(BENCH_CAPACITY, &ctx.queue) != ERR_SUCCESS ||
+        circbuf_allocate(BENCH_CAPACITY, &ctx.cb) != ERR_SUCCESS) {
+        printf("Could not allocate buffers\n");
+        return 1;
+    }
+    pthread_mutex_init(&ctx.lock, NULL);
+
+    printf("threads      mpmc Mops/s     mutex Mops/s\n");
+    for (long threads = 1; threads <= max_threads; threads++) {
+        double lockfree = bench_run(bench_mpmc_worker, &ctx, threads);
+        double locked = bench_run(bench_mutex_worker, &ctx, threads);
+        printf("%7ld %16.1f %16.1f\n", threads, lockfree / 1e6, locked / 1e6);
+    }
+
+    pthread_mutex_destroy(&ctx.lock);
+    circbuf_mpmc_destroy(ctx.queue);
+    circbuf_destroy(ctx.cb);
+    return 0;
+}
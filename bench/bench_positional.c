@@ -0,0 +1,242 @@
+/******************************************************************************
+* Copyright (C) 2017 by Ben Heberlein
+*
+* Redistribution, modification or use of this software in source or binary
+* forms is permitted as long as the files maintain this copyright. This file
+* was created for the University of Colorado Boulder course Advanced Practical
+* Embedded Software Development. Ben Heberlein and the University of Colorado
+* are not liable for any misuse of this material.
+*
+*******************************************************************************/
+/**
+ * @file bench_positional.c
+ * @brief Benchmark for add, get and remove at random positions
+ *
+ * This file builds lists of growing length by adding at random indices, then
+ * reads and removes at random indices, and reports the time per operation
+ * for the ll2 list handle, the unrolled list and the skip list. The first two
+ * walk to the index, the skip list jumps there. It then times a bulk load into
+ * the middle of a list with one ll2_add_node per value against one
+ * ll2_insert_array call, a pass that drops every other value by index
+ * against one with a cursor, and three ways to end up with random values in
+ * order: walking to the insert index and adding there, ll2_list_add_sorted,
+ * and appending everything before one ll2_list_sort.
+ *
+ * @author Ben Heberlein
+ * @date October 17 2026
+ * @version 1.0
+ *
+ */
+
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "ll2.h"
+#include "ll2u.h"
+#include "ll2s.h"
+
+#define BENCH_BULK 10000u
+
+/**
+ * @brief Returns a monotonic timestamp in seconds
+ *
+ * @return The current time in seconds
+ */
+static double bench_now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/**
+ * @brief Small generator so every container sees the same indices
+ *
+ * @param state The generator state
+ *
+ * @return The next random value
+ */
+static uint64_t bench_rand(uint64_t *state) {
+    uint64_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    *state = x;
+    return x;
+}
+
+/**
+ * @brief Prints nanoseconds per operation for one phase
+ *
+ * @param name The phase
+ * @param elapsed Seconds the phase took
+ * @param count Operations in the phase
+ */
+static void bench_report(const char *name, double elapsed, size_t count) {
+    printf(" %8s %9.1f", name, elapsed * 1e9 / count);
+}
+
+int main(void) {
+    static const size_t sizes[] = { 1000, 10000, 100000 };
+    volatile uint32_t sink = 0;
+
+    printf("ns per op, random index\n");
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+        size_t count = sizes[s];
+        uint64_t seed;
+        uint32_t data;
+        double start;
+
+        /* ll2 list handle, walks from the closer end */
+        ll2_list_t plain;
+        ll2_list_init(&plain, NULL);
+        printf("%7zu ll2 ", count);
+        seed = 88172645463325252ULL;
+        start = bench_now();
+        for (size_t i = 0; i < count; i++) {
+            ll2_list_add(&plain, (uint32_t) i, bench_rand(&seed) % (i + 1));
+        }
+        bench_report("add", bench_now() - start, count);
+        start = bench_now();
+        for (size_t i = count; i > 0; i--) {
+            ll2_list_remove(&plain, bench_rand(&seed) % i);
+        }
+        bench_report("remove", bench_now() - start, count);
+        ll2_list_destroy(&plain);
+        printf("\n");
+
+        /* Unrolled list, walks block by block */
+        ll2u_list_t unrolled;
+        ll2u_init(&unrolled);
+        printf("%7zu ll2u", count);
+        seed = 88172645463325252ULL;
+        start = bench_now();
+        for (size_t i = 0; i < count; i++) {
+            ll2u_add(&unrolled, (uint32_t) i, bench_rand(&seed) % (i + 1));
+        }
+        bench_report("add", bench_now() - start, count);
+        start = bench_now();
+        for (size_t i = 0; i < count; i++) {
+            ll2u_get(&unrolled, bench_rand(&seed) % count, &data);
+            sink += data;
+        }
+        bench_report("get", bench_now() - start, count);
+        start = bench_now();
+        for (size_t i = count; i > 0; i--) {
+            ll2u_remove(&unrolled, bench_rand(&seed) % i);
+        }
+        bench_report("remove", bench_now() - start, count);
+        ll2u_destroy(&unrolled);
+        printf("\n");
+
+        /* Skip list */
+        ll2s_list_t skip;
+        ll2s_init(&skip);
+        printf("%7zu ll2s", count);
+        seed = 88172645463325252ULL;
+        start = bench_now();
+        for (size_t i = 0; i < count; i++) {
+            ll2s_add(&skip, (uint32_t) i, bench_rand(&seed) % (i + 1));
+        }
+        bench_report("add", bench_now() - start, count);
+        start = bench_now();
+        for (size_t i = 0; i < count; i++) {
+            ll2s_get(&skip, bench_rand(&seed) % count, &data);
+            sink += data;
+        }
+        bench_report("get", bench_now() - start, count);
+        start = bench_now();
+        for (size_t i = count; i > 0; i--) {
+            ll2s_remove(&skip, bench_rand(&seed) % i);
+        }
+        bench_report("remove", bench_now() - start, count);
+        ll2s_destroy(&skip);
+        printf("\n");
+    }
+
+    /* Bulk load into the middle of the head based list */
+    static uint32_t values[BENCH_BULK];
+    ll2_node_t *head = NULL;
+    double start;
+
+    for (uint32_t i = 0; i < BENCH_BULK; i++) {
+        values[i] = i;
+    }
+    ll2_insert_array(&head, values, BENCH_BULK, 0);
+    start = bench_now();
+    for (uint16_t i = 0; i < BENCH_BULK; i++) {
+        ll2_add_node(&head, values[i], BENCH_BULK / 2 + i);
+    }
+    double single = bench_now() - start;
+    ll2_remove_range(&head, BENCH_BULK / 2, BENCH_BULK);
+    start = bench_now();
+    ll2_insert_array(&head, values, BENCH_BULK, BENCH_BULK / 2);
+    double batch = bench_now() - start;
+    ll2_destroy(&head);
+
+    printf("bulk %u values at index %u: ll2_add_node %.3f ms, ll2_insert_array %.3f ms\n",
+           BENCH_BULK, BENCH_BULK / 2, single * 1e3, batch * 1e3);
+
+    /* Drop every other value in one pass, by index and with a cursor */
+    ll2_list_t list;
+    ll2_cursor_t cursor;
+
+    ll2_list_init(&list, NULL);
+    ll2_list_insert_array(&list, values, BENCH_BULK, 0);
+    start = bench_now();
+    for (size_t i = 0; i < ll2_list_size(&list); i++) {
+        ll2_list_remove(&list, i);
+    }
+    single = bench_now() - start;
+    ll2_list_destroy(&list);
+
+    ll2_list_insert_array(&list, values, BENCH_BULK, 0);
+    start = bench_now();
+    ll2_list_cursor_init(&cursor, &list, 0);
+    while (ll2_cursor_remove(&cursor) == LL2_SUCCESS) {
+        ll2_cursor_next(&cursor);
+    }
+    batch = bench_now() - start;
+    ll2_list_destroy(&list);
+
+    printf("pass over %u values: ll2_list_remove %.3f ms, ll2_cursor_remove %.3f ms\n",
+           BENCH_BULK, single * 1e3, batch * 1e3);
+
+    /* Keep random values in order, the same values for every way */
+    uint64_t seed = 88172645463325252ULL;
+    for (uint32_t i = 0; i < BENCH_BULK; i++) {
+        values[i] = (uint32_t) bench_rand(&seed);
+    }
+
+    start = bench_now();
+    for (uint32_t i = 0; i < BENCH_BULK; i++) {
+        size_t index = 0;
+        for (ll2_node_t *node = list.head; node != NULL && node->data <= values[i]; node = node->next) {
+            index++;
+        }
+        ll2_list_add(&list, values[i], index);
+    }
+    single = bench_now() - start;
+    ll2_list_destroy(&list);
+
+    start = bench_now();
+    for (uint32_t i = 0; i < BENCH_BULK; i++) {
+        ll2_list_add_sorted(&list, values[i]);
+    }
+    double sorted = bench_now() - start;
+    ll2_list_destroy(&list);
+
+    start = bench_now();
+    ll2_list_insert_array(&list, values, BENCH_BULK, 0);
+    ll2_list_sort(&list);
+    batch = bench_now() - start;
+    ll2_list_destroy(&list);
+
+    printf("order %u random values: walk and ll2_list_add %.3f ms, ll2_list_add_sorted %.3f ms, "
+           "append and ll2_list_sort %.3f ms\n", BENCH_BULK, single * 1e3, sorted * 1e3, batch * 1e3);
+
+    (void) sink;
+    return 0;
+}
@@ -0,0 +1,251 @@
+/******************************************************************************
+* Copyright (C) 2017 by Ben Heberlein
+*
+* Redistribution, modification or use of this software in source or binary
+* forms is permitted as long as the files maintain this copyright. This file
+* was created for the University of Colorado Boulder course Advanced Practical
+* Embedded Software Development. Ben Heberlein and the University of Colorado
+* are not liable for any misuse of this material.
+*
+*******************************************************************************/
+/**
+ * @file bench_shm.c
+ * @brief Two process benchmark for the shared memory channel
+ *
+ * This file forks a consumer process and measures message throughput and
+ * ping-pong latency between the two processes for a circbuf_shm_t channel
+ * that polls, one that sleeps on eventfds, and a pair of pipes as the
+ * baseline. Latency is half the average round trip time.
+ *
+ * @author Ben Heberlein
+ * @date October 17 2026
+ * @version 1.0
+ *
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include "circbuf_shm.h"
+
+#define BENCH_MSGS 500000UL
+#define BENCH_ROUNDS 100000UL
+#define BENCH_CAPACITY (1UL << 20)
+#define BENCH_MAX_MSG 1024
+
+/**
+ * @brief Transports that are compared
+ */
+typedef enum bench_mode_e {
+    BENCH_SHM_POLL,
+    BENCH_SHM_EVENTFD,
+    BENCH_PIPE
+} bench_mode_t;
+
+static const char *bench_mode_names[] = { "shm poll", "shm eventfd", "pipe" };
+
+/**
+ * @brief One direction of a transport
+ */
+typedef struct bench_link_s {
+    circbuf_shm_t *ch;
+    int fds[2];
+} bench_link_t;
+
+/**
+ * @brief Returns a monotonic timestamp in seconds
+ *
+ * @return The current time in seconds
+ */
+static double bench_now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/**
+ * @brief Sets up one direction of a transport before the fork
+ *
+ * @param link The link to set up
+ * @param mode The transport to use
+ *
+ * @return 0 on success, -1 on failure
+ */
+static int bench_link_open(bench_link_t *link, bench_mode_t mode) {
+    static int serial = 0;
+    char name[64];
+
+    link->ch = NULL;
+    if (mode == BENCH_PIPE) {
+        return pipe(link->fds);
+    }
+
+    // The name is only needed until the child has inherited the mapping
+    snprintf(name, sizeof(name), "/circbuf_bench_%ld_%d", (long) getpid(), serial++);
+    uint32_t flags = (mode == BENCH_SHM_EVENTFD) ? CIRCBUF_SHM_EVENTFD : 0;
+    if (circbuf_shm_create(name, BENCH_CAPACITY, flags, &link->ch) != ERR_SUCCESS) {
+        return -1;
+    }
+    circbuf_shm_unlink(name);
+    return 0;
+}
+
+/**
+ * @brief Releases one direction of a transport
+ *
+ * @param link The link to release
+ */
+static void bench_link_close(bench_link_t *link) {
+    if (link->ch != NULL) {
+        circbuf_shm_close(link->ch);
+    } else {
+        close(link->fds[0]);
+        close(link->fds[1]);
+    }
+}
+
+/**
+ * @brief Sends one message, waiting for room
+ *
+ * @param link The link to send on
+ * @param msg The message
+ * @param len The message length
+ */
+static void bench_send(bench_link_t *link, const void *msg, size_t len) {
+    if (link->ch != NULL) {
+        circbuf_shm_send_timed(link->ch, msg, len, CIRCBUF_WAIT_FOREVER);
+        return;
+    }
+
+    // Messages are under PIPE_BUF so writes are never split
+    if (write(link->fds[1], msg, len) != (ssize_t) len) {
+        exit(1);
+    }
+}
+
+/**
+ * @brief Receives one message of a known length, waiting for it
+ *
+ * @param link The link to receive from
+ * @param buf Where to put the message
+ * @param len The message length
+ */
+static void bench_recv(bench_link_t *link, void *buf, size_t len) {
+    if (link->ch != NULL) {
+        size_t got;
+        circbuf_shm_recv_timed(link->ch, buf, len, &got, CIRCBUF_WAIT_FOREVER);
+        return;
+    }
+
+    size_t got = 0;
+    while (got < len) {
+        ssize_t n = read(link->fds[0], (uint8_t *) buf + got, len - got);
+        if (n <= 0) {
+            exit(1);
+        }
+        got += (size_t) n;
+    }
+}
+
+/**
+ * @brief Measures one way throughput to a child process
+ *
+ * @param mode The transport to use
+ * @param len The message length
+ *
+ * @return Messages per second
+ */
+static double bench_throughput(bench_mode_t mode, size_t len) {
+    uint8_t msg[BENCH_MAX_MSG];
+    bench_link_t link;
+
+    if (bench_link_open(&link, mode) != 0) {
+        return 0.0;
+    }
+    memset(msg, 0xa5, sizeof(msg));
+
+    pid_t pid = fork();
+    if (pid == 0) {
+        for (unsigned long i = 0; i < BENCH_MSGS; i++) {
+            bench_recv(&link, msg, len);
+        }
+        _exit(0);
+    }
+
+    double start = bench_now();
+    for (unsigned long i = 0; i < BENCH_MSGS; i++) {
+        bench_send(&link, msg, len);
+    }
+    waitpid(pid, NULL, 0);
+    double elapsed = bench_now() - start;
+
+    bench_link_close(&link);
+    return BENCH_MSGS / elapsed;
+}
+
+/**
+ * @brief Measures one way latency with a child that echoes every message
+ *
+ * @param mode The transport to use
+ * @param len The message length
+ *
+ * @return Average one way latency in nanoseconds
+ */
+static double bench_latency(bench_mode_t mode, size_t len) {
+    uint8_t msg[BENCH_MAX_MSG];
+    bench_link_t ping;
+    bench_link_t pong;
+
+    if (bench_link_open(&ping, mode) != 0) {
+        return 0.0;
+    }
+    if (bench_link_open(&pong, mode) != 0) {
+        bench_link_close(&ping);
+        return 0.0;
+    }
+    memset(msg, 0x5a, sizeof(msg));
+
+    pid_t pid = fork();
+    if (pid == 0) {
+        for (unsigned long i = 0; i < BENCH_ROUNDS; i++) {
+            bench_recv(&ping, msg, len);
+            bench_send(&pong, msg, len);
+        }
+        _exit(0);
+    }
+
+    double start = bench_now();
+    for (unsigned long i = 0; i < BENCH_ROUNDS; i++) {
+        bench_send(&ping, msg, len);
+        bench_recv(&pong, msg, len);
+    }
+    double elapsed = bench_now() - start;
+    waitpid(pid, NULL, 0);
+
+    bench_link_close(&ping);
+    bench_link_close(&pong);
+    return elapsed * 1e9 / (2.0 * BENCH_ROUNDS);
+}
+
+int main(void) {
+    static const size_t sizes[] = { 64, BENCH_MAX_MSG };
+
+    printf("transport       bytes     Mmsg/s       MB/s   latency ns\n");
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+        for (int mode = BENCH_SHM_POLL; mode <= BENCH_PIPE; mode++) {
+            double rate = bench_throughput((bench_mode_t) mode, sizes[s]);
+            double lat = bench_latency((bench_mode_t) mode, sizes[s]);
+            printf("%-12s %8zu %10.2f %10.1f %12.0f\n", bench_mode_names[mode], sizes[s],
+                   rate / 1e6, rate * sizes[s] / 1e6, lat);
+        }
+    }
+
+    return 0;
+}
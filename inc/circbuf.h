@@ -14,7 +14,54 @@
 #ifndef CIRCBUF_H
 #define CIRCBUF_H
 
+#include <stddef.h>
 #include <stdint.h>
+#include <stdatomic.h>
+
+/**********************************************************
+* Type used for capacities, sizes and counts. Embedded
+* builds define CIRCBUF_EMBEDDED to keep the original
+* 16 bit fields and 1024 item limit, everything else gets
+* size_t so buffers can hold millions of items.
+**********************************************************/
+#ifdef CIRCBUF_EMBEDDED
+typedef uint16_t circbuf_count_t;
+#else
+typedef size_t circbuf_count_t;
+#endif
+
+/**********************************************************
+* The blocking functions sleep on a Linux futex, so they
+* only exist on Linux hosts. Pass CIRCBUF_WAIT_FOREVER as
+* the timeout to wait without a limit.
+**********************************************************/
+#if defined(__linux__) && !defined(CIRCBUF_EMBEDDED)
+#define CIRCBUF_HAVE_WAIT
+#define CIRCBUF_WAIT_FOREVER UINT64_MAX
+#endif
+
+/**********************************************************
+* Assumed cache line size, used to keep the producer and
+* consumer fields of the lock-free buffers apart.
+**********************************************************/
+#define CIRCBUF_CACHE_LINE 64
+
+/**********************************************************
+* Build with -DCIRCBUF_STATS to keep occupancy and
+* contention counters in every buffer, read out with
+* circbuf_stats and circbuf_spsc_stats. Bucket 0 of the
+* histogram counts an empty buffer and bucket k a level
+* from 2^(k-1) up to 2^k - 1. The lock-free buffer only
+* samples its level every CIRCBUF_STATS_PERIOD adds, since
+* reading the consumer's tail on each add would cost the
+* cache line traffic it was built to avoid.
+**********************************************************/
+#ifdef CIRCBUF_EMBEDDED
+#define CIRCBUF_STATS_BUCKETS 12
+#else
+#define CIRCBUF_STATS_BUCKETS 33
+#endif
+#define CIRCBUF_STATS_PERIOD 64
 
 /**********************************************************
 * This is the circular buffer state enum used in the
@@ -25,16 +72,104 @@ typedef enum circbuf_state {PARTIAL=0, EMPTY, FULL, INVALID} circbuf_state_t;
 /*********************************************************
 * This is the circular buffer error enumeration
 *********************************************************/
-typedef enum circbuf_err {ERR_PARTIAL=0, ERR_EMPTY=1, ERR_FULL=2, ERR_SUCCESS=3, 
+typedef enum circbuf_err {ERR_PARTIAL=0, ERR_EMPTY=1, ERR_FULL=2, ERR_SUCCESS=3, ERR_NOTFOUND=4,
                           ERR_CONFIG=-1, ERR_MEM=-2, ERR_NULLPTR=-3, ERR_UNKNOWN=-4} circbuf_err_t;
 
+/*********************************************************
+* These are the mode flags for circbuf_allocate_ex
+*********************************************************/
+typedef enum circbuf_flag {CIRCBUF_POW2=0x01, CIRCBUF_OVERWRITE=0x02,
+                           CIRCBUF_MAPPED=0x04, CIRCBUF_READONLY=0x08} circbuf_flag_t;
+
+/**********************************************************
+* circbuf_pos_t
+* Author: Ben Heberlein
+* Date: 10/17/2026
+* Description: Positions and counters of a circular buffer
+* that are kept as plain fixed width integers, so they can
+* live in a file mapping and be read by another process.
+* in and out are the CIRCBUF_POW2 indices, the rest
+* belongs to CIRCBUF_OVERWRITE mode.
+**********************************************************/
+typedef struct circbuf_pos {
+
+    uint32_t in;
+    uint32_t out;
+    uint64_t dropped;
+    _Atomic uint64_t seq;
+    _Atomic uint64_t seq_begin;
+
+} circbuf_pos_t;
+
+/**********************************************************
+* circbuf_stats_t
+* Author: Ben Heberlein
+* Date: 10/17/2026
+* Description: Counters copied out by circbuf_stats and
+* circbuf_spsc_stats. full counts adds turned away with
+* ERR_FULL, or items left over by circbuf_add_n, and empty
+* counts removes that found nothing. The blocking calls
+* retry, so each failed try is counted. high_water is the
+* highest level seen and histogram holds one count per
+* level sample, bucketed by CIRCBUF_STATS_BUCKETS.
+**********************************************************/
+typedef struct circbuf_stats {
+
+    uint64_t adds;
+    uint64_t removes;
+    uint64_t full;
+    uint64_t empty;
+    uint64_t high_water;
+    uint64_t histogram[CIRCBUF_STATS_BUCKETS];
+
+} circbuf_stats_t;
+
+#ifdef CIRCBUF_STATS
+/**********************************************************
+* circbuf_prod_stats_t, circbuf_cons_stats_t
+* Author: Ben Heberlein
+* Date: 10/17/2026
+* Description: The live counters, split by the side that
+* writes them so that each stays in its owner's cache
+* lines. Owners update them with plain relaxed loads and
+* stores, they are only atomic so circbuf_stats can read
+* them from another thread.
+**********************************************************/
+typedef struct circbuf_prod_stats {
+
+    _Atomic uint64_t adds;
+    _Atomic uint64_t full;
+    _Atomic uint64_t high_water;
+    _Atomic uint64_t histogram[CIRCBUF_STATS_BUCKETS];
+
+} circbuf_prod_stats_t;
+
+typedef struct circbuf_cons_stats {
+
+    _Atomic uint64_t removes;
+    _Atomic uint64_t empty;
+
+} circbuf_cons_stats_t;
+#endif
+
 /**********************************************************
 * circbuf_t
 * Author: Ben Heberlein
 * Date: 09/25/2016
 * Description: This is the main circular buffer structure.
 * It has fields for buffer memory, headm tail, capacity,
-* current size, and internal state.
+* current size, and internal state. map_len is non zero
+* when buf came from mmap instead of the heap. In CIRCBUF_POW2 mode
+* head, tail, size and STATUS are not used and the buffer
+* runs on the free running in and out indices instead.
+* In CIRCBUF_OVERWRITE mode a full buffer drops its oldest
+* item to make room, counting it in dropped. seq counts
+* every item ever written and seq_begin is raised before a
+* write starts, which lets circbuf_snapshot run alongside
+* the producer. pos points at pos_local, or into the file
+* header for CIRCBUF_MAPPED buffers. With CIRCBUF_STATS
+* the add and remove counters sit on cache lines of their
+* own, so the struct must be allocated aligned.
 **********************************************************/
 typedef struct circbuf {
 
@@ -42,13 +177,130 @@ typedef struct circbuf {
     uint32_t *head;
     uint32_t *tail;
 
-    uint16_t capacity;
-    uint16_t size;
+    circbuf_count_t capacity;
+    circbuf_count_t size;
 
     circbuf_state_t STATUS;
 
+    uint32_t flags;
+    uint32_t mask;
+    circbuf_pos_t *pos;
+
+    size_t map_len;
+
+    circbuf_pos_t pos_local;
+
+#ifdef CIRCBUF_STATS
+    _Alignas(CIRCBUF_CACHE_LINE) circbuf_prod_stats_t prod_stats;
+    _Alignas(CIRCBUF_CACHE_LINE) circbuf_cons_stats_t cons_stats;
+#endif
+
 } circbuf_t;
 
+#ifndef CIRCBUF_EMBEDDED
+/**********************************************************
+* circbuf_file_hdr_t
+* Author: Ben Heberlein
+* Date: 10/17/2026
+* Description: Header at the start of a file backed buffer.
+* Version 1 layout, all fields in host byte order:
+*
+*   offset  size  field
+*        0     4  magic, CIRCBUF_FILE_MAGIC
+*        4     4  version, CIRCBUF_FILE_VERSION
+*        8     4  data_offset, where item 0 starts
+*       12     4  elem_size, bytes per item (4)
+*       16     8  capacity, a power of two
+*       24     4  flags the buffer was created with
+*       28     4  reserved, zero
+*       32     4  in, free running write index
+*       36     4  out, free running read index
+*       40     8  dropped
+*       48     8  seq
+*       56     8  seq_begin
+*
+* Item i of the buffer is at data_offset + 4 * (i & (capacity - 1)).
+* The live positions are updated in place on every call,
+* so after a crash the file holds the buffer exactly as
+* it was. New fields may only be added after seq_begin,
+* and data_offset leaves room for them.
+**********************************************************/
+#define CIRCBUF_FILE_MAGIC 0x46554243u
+#define CIRCBUF_FILE_VERSION 1u
+#define CIRCBUF_FILE_DATA_OFFSET 4096u
+
+typedef struct circbuf_file_hdr {
+
+    uint32_t magic;
+    uint32_t version;
+    uint32_t data_offset;
+    uint32_t elem_size;
+    uint64_t capacity;
+    uint32_t flags;
+    uint32_t reserved;
+
+    circbuf_pos_t pos;
+
+} circbuf_file_hdr_t;
+#endif
+
+/**********************************************************
+* circbuf_region_t
+* Author: Ben Heberlein
+* Date: 10/17/2026
+* Description: Up to two contiguous runs inside a circular
+* buffer's memory, as handed out by circbuf_reserve and
+* circbuf_peek. The second run starts at the beginning of
+* buf and is only used when the region wraps, otherwise
+* its length is zero.
+**********************************************************/
+typedef struct circbuf_region {
+
+    uint32_t *span[2];
+    circbuf_count_t len[2];
+
+} circbuf_region_t;
+
+/**********************************************************
+* circbuf_spsc_t
+* Author: Ben Heberlein
+* Date: 10/17/2026
+* Description: Lock-free single producer, single consumer
+* circular buffer. The producer only writes head and the
+* consumer only writes tail, each on its own cache line
+* together with a private copy of the other side's index.
+* One slot is left unused so full and empty can be told
+* apart without a shared size field. A side that goes to
+* sleep in a blocking call raises its waiting flag in the
+* other side's cache line, and the spin counts are each
+* side's adaptive spin budget before sleeping. With
+* CIRCBUF_STATS each side's counters follow its fields.
+**********************************************************/
+typedef struct circbuf_spsc {
+
+    uint32_t *buf;
+    size_t map_len;
+    uint32_t slots;
+    circbuf_count_t capacity;
+
+    _Alignas(CIRCBUF_CACHE_LINE) _Atomic uint32_t head;
+    uint32_t tail_cache;
+    _Atomic uint32_t cons_waiting;
+    uint32_t prod_spin;
+#ifdef CIRCBUF_STATS
+    circbuf_prod_stats_t prod_stats;
+#endif
+
+    _Alignas(CIRCBUF_CACHE_LINE) _Atomic uint32_t tail;
+    uint32_t head_cache;
+    _Atomic uint32_t prod_waiting;
+    uint32_t cons_spin;
+#ifdef CIRCBUF_STATS
+    circbuf_cons_stats_t cons_stats;
+#endif
+
+} circbuf_spsc_t;
+
 /***********************************************************
 * circbuf_is_full     : circbuf_err_t circbuf_is_full(circbuf_t *circular_buffer);
 *   returns           : ERR_FULL for full (true), ERR_PARTIAL for not full (false), or other error
@@ -92,14 +344,138 @@ circbuf_err_t circbuf_add(uint32_t data, circbuf_t *circular_buffer);
 circbuf_err_t circbuf_remove(uint32_t *data, circbuf_t *circular_buffer);
 
 /***********************************************************
-* circbuf_allocate   : circbuf_err_t circbuf_allocate(uint16_t capacity, circbuf_t **circular_buffer);
+* circbuf_add_n     : circbuf_count_t circbuf_add_n(const uint32_t *data, circbuf_count_t count, circbuf_t *circular_buffer);
+*   returns         : Number of items actually added, 0 if full or on error.
+*                     In CIRCBUF_OVERWRITE mode all count items are taken
+*                     and the oldest ones are dropped to make room.
+*   data            : Array of data to be added
+*   count           : Number of items in data
+*   circular_buffer : The circular buffer to be added to
+* Author            : Ben Heberlein
+* Date              : 10/17/2026
+* Description       : Add as many items as fit, copying at most two runs
+*                     around the wrap and updating the state once
+***********************************************************/
+circbuf_count_t circbuf_add_n(const uint32_t *data, circbuf_count_t count, circbuf_t *circular_buffer);
+
+/***********************************************************
+* circbuf_remove_n  : circbuf_count_t circbuf_remove_n(uint32_t *data, circbuf_count_t count, circbuf_t *circular_buffer);
+*   returns         : Number of items actually removed, 0 if empty or on error
+*   data            : Array to put data in, must hold count items
+*   count           : Maximum number of items to remove
+*   circular_buffer : The circular buffer to get data from
+* Author            : Ben Heberlein
+* Date              : 10/17/2026
+* Description       : Remove up to count items, copying at most two runs
+*                     around the wrap and updating the state once
+***********************************************************/
+circbuf_count_t circbuf_remove_n(uint32_t *data, circbuf_count_t count, circbuf_t *circular_buffer);
+
+/***********************************************************
+* circbuf_reserve   : circbuf_count_t circbuf_reserve(circbuf_count_t count, circbuf_region_t *region, circbuf_t *circular_buffer);
+*   returns         : Number of items reserved, 0 if full or on error
+*   count           : Maximum number of items wanted
+*   region          : Filled with the writable runs
+*   circular_buffer : The circular buffer to write into
+* Author            : Ben Heberlein
+* Date              : 10/17/2026
+* Description       : Hand out free space after head for writing in place.
+*                     Nothing is added until circbuf_commit is called.
+*                     Never overwrites, even in CIRCBUF_OVERWRITE mode.
+***********************************************************/
+circbuf_count_t circbuf_reserve(circbuf_count_t count, circbuf_region_t *region, circbuf_t *circular_buffer);
+
+/***********************************************************
+* circbuf_commit    : circbuf_err_t circbuf_commit(circbuf_count_t count, circbuf_t *circular_buffer);
+*   returns         : ERR_SUCCESS for success, ERR_CONFIG if count is more than
+*                     the free space, or other error
+*   count           : Number of reserved items that were written
+*   circular_buffer : The circular buffer that was written into
+* Author            : Ben Heberlein
+* Date              : 10/17/2026
+* Description       : Add the first count items of the last reservation
+***********************************************************/
+circbuf_err_t circbuf_commit(circbuf_count_t count, circbuf_t *circular_buffer);
+
+/***********************************************************
+* circbuf_peek      : circbuf_count_t circbuf_peek(circbuf_count_t count, circbuf_region_t *region, circbuf_t *circular_buffer);
+*   returns         : Number of items visible, 0 if empty or on error
+*   count           : Maximum number of items wanted
+*   region          : Filled with the readable runs, oldest first
+*   circular_buffer : The circular buffer to read from
+* Author            : Ben Heberlein
+* Date              : 10/17/2026
+* Description       : Hand out stored items starting at tail for reading in
+*                     place. Nothing is removed until circbuf_release is called.
+***********************************************************/
+circbuf_count_t circbuf_peek(circbuf_count_t count, circbuf_region_t *region, circbuf_t *circular_buffer);
+
+/***********************************************************
+* circbuf_release   : circbuf_err_t circbuf_release(circbuf_count_t count, circbuf_t *circular_buffer);
+*   returns         : ERR_SUCCESS for success, ERR_CONFIG if count is more than
+*                     the current size, or other error
+*   count           : Number of peeked items that are done with
+*   circular_buffer : The circular buffer that was read from
+* Author            : Ben Heberlein
+* Date              : 10/17/2026
+* Description       : Remove the oldest count items without copying them
+***********************************************************/
+circbuf_err_t circbuf_release(circbuf_count_t count, circbuf_t *circular_buffer);
+
+/***********************************************************
+* circbuf_allocate   : circbuf_err_t circbuf_allocate(circbuf_count_t capacity, circbuf_t **circular_buffer);
 *   returns          : ERR_SUCCESS if successful, or another error if failed with *circular_buffer set to NULL
-*   capacity		 : Capacity of the buffer
+*   capacity		 : Capacity of the buffer, at most 1024 for embedded builds
 * Author             : Ben Heberlein
 * Date               : 9/7/2017
 * Description        : Initialize a new circular buffer and put it at the location of circular_buffer
 ***********************************************************/
-circbuf_err_t circbuf_allocate(uint16_t capacity, circbuf_t **circular_buffer);
+circbuf_err_t circbuf_allocate(circbuf_count_t capacity, circbuf_t **circular_buffer);
+
+/***********************************************************
+* circbuf_allocate_ex : circbuf_err_t circbuf_allocate_ex(circbuf_count_t capacity, uint32_t flags, circbuf_t **circular_buffer);
+*   returns           : ERR_SUCCESS if successful, or another error if failed with *circular_buffer set to NULL
+*   capacity          : Capacity of the buffer, must be a power of two for CIRCBUF_POW2
+*   flags             : Bitwise or of circbuf_flag_t values
+* Author              : Ben Heberlein
+* Date                : 10/17/2026
+* Description         : Initialize a new circular buffer in the given mode
+***********************************************************/
+circbuf_err_t circbuf_allocate_ex(circbuf_count_t capacity, uint32_t flags, circbuf_t **circular_buffer);
+
+#ifndef CIRCBUF_EMBEDDED
+/***********************************************************
+* circbuf_map        : circbuf_err_t circbuf_map(const char *path, circbuf_count_t capacity, uint32_t flags, circbuf_t **circular_buffer);
+*   returns          : ERR_SUCCESS if successful, ERR_CONFIG if the file holds a
+*                      different or newer buffer, or another error
+*   path             : File to keep the buffer in, e.g. under /dev/shm
+*   capacity         : Capacity of the buffer, must be a power of two
+*   flags            : Bitwise or of circbuf_flag_t values, CIRCBUF_POW2 is implied
+*   circular_buffer  : Location to put the new buffer
+* Author             : Ben Heberlein
+* Date               : 10/17/2026
+* Description        : Initialize a circular buffer whose header and items live
+*                      in a shared file mapping, so its contents survive a crash
+*                      of the process. If the file already holds a buffer with
+*                      the same capacity it is picked up where it left off.
+***********************************************************/
+circbuf_err_t circbuf_map(const char *path, circbuf_count_t capacity, uint32_t flags, circbuf_t **circular_buffer);
+
+/***********************************************************
+* circbuf_attach     : circbuf_err_t circbuf_attach(const char *path, circbuf_t **circular_buffer);
+*   returns          : ERR_SUCCESS if successful, ERR_CONFIG if the file is not a
+*                      buffer this version understands, or another error
+*   path             : File written by circbuf_map
+*   circular_buffer  : Location to put the read only view
+* Author             : Ben Heberlein
+* Date               : 10/17/2026
+* Description        : Map an existing file backed buffer read only, for example
+*                      from another process or a post-mortem tool. Only
+*                      functions that do not change the buffer may be used, the
+*                      others return ERR_CONFIG. Release it with circbuf_destroy.
+***********************************************************/
+circbuf_err_t circbuf_attach(const char *path, circbuf_t **circular_buffer);
+#endif
 
 /***********************************************************
 * circbuf_destroy    : circbuf_err_t circbuf_destroy(circbuf_t *circular_buf);
@@ -122,13 +498,207 @@ circbuf_err_t circbuf_destroy(circbuf_t *circular_buf);
 circbuf_err_t circbuf_dump(circbuf_t *circular_buf);
 
 /***********************************************************
-* circbuf_size       : uint16_t circbuf_size(circbuf_t *circular_buf);
+* circbuf_size       : circbuf_count_t circbuf_size(circbuf_t *circular_buf);
 *   return           : current_number of items stored
 *   circular)buf     : Circular buffer to get size of
 * Author             : Ben Heberlein
 * Date               : 09/07/2017
 * Description        : Returns the size of the given circular buffer
 ***********************************************************/
-uint16_t circbuf_size(circbuf_t *circular_buf);
+circbuf_count_t circbuf_size(circbuf_t *circular_buf);
+
+/***********************************************************
+* circbuf_dropped    : uint64_t circbuf_dropped(circbuf_t *circular_buf);
+*   return           : number of items dropped, 0 on error
+*   circular_buf     : Circular buffer in CIRCBUF_OVERWRITE mode
+* Author             : Ben Heberlein
+* Date               : 10/17/2026
+* Description        : Returns how many items have been overwritten or
+*                      skipped because the buffer was full
+***********************************************************/
+uint64_t circbuf_dropped(circbuf_t *circular_buf);
+
+/***********************************************************
+* circbuf_snapshot   : circbuf_count_t circbuf_snapshot(uint32_t *data, circbuf_count_t count, circbuf_t *circular_buf);
+*   return           : number of items copied, 0 on error
+*   data             : Array to copy into, oldest item first
+*   count            : Maximum number of items wanted
+*   circular_buf     : Circular buffer in CIRCBUF_OVERWRITE mode
+* Author             : Ben Heberlein
+* Date               : 10/17/2026
+* Description        : Copies the newest count items ever written without
+*                      removing them, whether or not they have been read.
+*                      Takes no lock and may run on another thread while
+*                      the producer keeps adding. Items the producer
+*                      overwrote during the copy are left out, so fewer
+*                      than count may come back.
+***********************************************************/
+circbuf_count_t circbuf_snapshot(uint32_t *data, circbuf_count_t count, circbuf_t *circular_buf);
+
+/***********************************************************
+* circbuf_stats      : circbuf_err_t circbuf_stats(circbuf_stats_t *stats, circbuf_t *circular_buf);
+*   return           : ERR_SUCCESS, ERR_CONFIG if built without CIRCBUF_STATS,
+*                      or other error
+*   stats            : Filled with a copy of the counters
+*   circular_buf     : Circular buffer to read the counters of
+* Author             : Ben Heberlein
+* Date               : 10/17/2026
+* Description        : Copies out the occupancy and contention counters.
+*                      Takes no lock, so while the buffer is in use the
+*                      counters may be a few operations apart.
+***********************************************************/
+circbuf_err_t circbuf_stats(circbuf_stats_t *stats, circbuf_t *circular_buf);
+
+/***********************************************************
+* circbuf_find       : circbuf_err_t circbuf_find(uint32_t data, circbuf_count_t *index, circbuf_t *circular_buf);
+*   return           : ERR_SUCCESS if found, ERR_NOTFOUND if not, or other error
+*   data             : Value to look for
+*   index            : Set to the position of the first match, 0 being the oldest item
+*   circular_buf     : Circular buffer to search
+* Author             : Ben Heberlein
+* Date               : 10/17/2026
+* Description        : Find the oldest stored item equal to data without
+*                      removing anything. Both runs around the wrap are
+*                      scanned with the widest SIMD kernel the CPU has.
+***********************************************************/
+circbuf_err_t circbuf_find(uint32_t data, circbuf_count_t *index, circbuf_t *circular_buf);
+
+/***********************************************************
+* circbuf_find_range : circbuf_err_t circbuf_find_range(uint32_t lo, uint32_t hi, circbuf_count_t *index, circbuf_t *circular_buf);
+*   return           : ERR_SUCCESS if found, ERR_NOTFOUND if not, or other error
+*   lo               : Smallest value that matches
+*   hi               : Largest value that matches
+*   index            : Set to the position of the first match, 0 being the oldest item
+*   circular_buf     : Circular buffer to search
+* Author             : Ben Heberlein
+* Date               : 10/17/2026
+* Description        : Find the oldest stored item with lo <= item <= hi,
+*                      searched the same way as circbuf_find
+***********************************************************/
+circbuf_err_t circbuf_find_range(uint32_t lo, uint32_t hi, circbuf_count_t *index, circbuf_t *circular_buf);
+
+/***********************************************************
+* circbuf_spsc_allocate : circbuf_err_t circbuf_spsc_allocate(circbuf_count_t capacity, circbuf_spsc_t **ring);
+*   returns             : ERR_SUCCESS if successful, or another error if failed
+*   capacity            : Capacity of the buffer
+*   ring                : Location to put the new buffer
+* Author                : Ben Heberlein
+* Date                  : 10/17/2026
+* Description           : Initialize a new single producer, single consumer buffer
+***********************************************************/
+circbuf_err_t circbuf_spsc_allocate(circbuf_count_t capacity, circbuf_spsc_t **ring);
+
+/***********************************************************
+* circbuf_spsc_destroy : circbuf_err_t circbuf_spsc_destroy(circbuf_spsc_t *ring);
+*   returns            : ERR_SUCCESS for successful destroy or other error
+*   ring               : Buffer to destroy, must not be in use by either thread
+* Author               : Ben Heberlein
+* Date                 : 10/17/2026
+* Description          : Destroy an existing single producer, single consumer buffer
+***********************************************************/
+circbuf_err_t circbuf_spsc_destroy(circbuf_spsc_t *ring);
+
+/***********************************************************
+* circbuf_spsc_add  : circbuf_err_t circbuf_spsc_add(uint32_t data, circbuf_spsc_t *ring);
+*   returns         : ERR_SUCCESS for success, ERR_FULL if full, or other error
+*   data            : The data to be added
+*   ring            : The buffer to be added to
+* Author            : Ben Heberlein
+* Date              : 10/17/2026
+* Description       : Add an item, may only be called from the producer thread
+***********************************************************/
+circbuf_err_t circbuf_spsc_add(uint32_t data, circbuf_spsc_t *ring);
+
+/***********************************************************
+* circbuf_spsc_remove : circbuf_err_t circbuf_spsc_remove(uint32_t *data, circbuf_spsc_t *ring);
+*   returns           : ERR_SUCCESS for success, ERR_EMPTY if empty, or other error
+*   data              : Pointer to where to put data
+*   ring              : The buffer to get data from
+* Author              : Ben Heberlein
+* Date                : 10/17/2026
+* Description         : Remove an item, may only be called from the consumer thread
+***********************************************************/
+circbuf_err_t circbuf_spsc_remove(uint32_t *data, circbuf_spsc_t *ring);
+
+/***********************************************************
+* circbuf_spsc_size  : circbuf_count_t circbuf_spsc_size(circbuf_spsc_t *ring);
+*   return           : number of items stored
+*   ring             : Buffer to get size of
+* Author             : Ben Heberlein
+* Date               : 10/17/2026
+* Description        : Returns the size of the buffer. When called while the
+*                      other side is running the result is only a snapshot.
+***********************************************************/
+circbuf_count_t circbuf_spsc_size(circbuf_spsc_t *ring);
+
+/***********************************************************
+* circbuf_spsc_stats : circbuf_err_t circbuf_spsc_stats(circbuf_stats_t *stats, circbuf_spsc_t *ring);
+*   return           : ERR_SUCCESS, ERR_CONFIG if built without CIRCBUF_STATS,
+*                      or other error
+*   stats            : Filled with a copy of the counters
+*   ring             : Buffer to read the counters of
+* Author             : Ben Heberlein
+* Date               : 10/17/2026
+* Description        : Copies out the occupancy and contention counters.
+*                      May be called from any thread while both sides run.
+*                      high_water and histogram come from the level samples
+*                      taken every CIRCBUF_STATS_PERIOD adds, and from adds
+*                      that found the buffer full.
+***********************************************************/
+circbuf_err_t circbuf_spsc_stats(circbuf_stats_t *stats, circbuf_spsc_t *ring);
+
+#ifdef CIRCBUF_HAVE_WAIT
+/***********************************************************
+* circbuf_spsc_add_timed : circbuf_err_t circbuf_spsc_add_timed(uint32_t data, uint64_t timeout_ns, circbuf_spsc_t *ring);
+*   returns              : ERR_SUCCESS for success, ERR_FULL on timeout, or other error
+*   data                 : The data to be added
+*   timeout_ns           : Longest time to wait in nanoseconds, or CIRCBUF_WAIT_FOREVER
+*   ring                 : The buffer to be added to
+* Author                 : Ben Heberlein
+* Date                   : 10/17/2026
+* Description            : Add an item, waiting for space if full. Spins for a
+*                          short, adaptive time and then sleeps until the
+*                          consumer takes an item out of the full buffer.
+*                          May only be called from the producer thread.
+***********************************************************/
+circbuf_err_t circbuf_spsc_add_timed(uint32_t data, uint64_t timeout_ns, circbuf_spsc_t *ring);
+
+/***********************************************************
+* circbuf_spsc_remove_timed : circbuf_err_t circbuf_spsc_remove_timed(uint32_t *data, uint64_t timeout_ns, circbuf_spsc_t *ring);
+*   returns                 : ERR_SUCCESS for success, ERR_EMPTY on timeout, or other error
+*   data                    : Pointer to where to put data
+*   timeout_ns              : Longest time to wait in nanoseconds, or CIRCBUF_WAIT_FOREVER
+*   ring                    : The buffer to get data from
+* Author                    : Ben Heberlein
+* Date                      : 10/17/2026
+* Description               : Remove an item, waiting for one if empty. Spins for
+*                             a short, adaptive time and then sleeps until the
+*                             producer adds to the empty buffer. May only be
+*                             called from the consumer thread.
+***********************************************************/
+circbuf_err_t circbuf_spsc_remove_timed(uint32_t *data, uint64_t timeout_ns, circbuf_spsc_t *ring);
+
+/***********************************************************
+* circbuf_spsc_add_wait : circbuf_err_t circbuf_spsc_add_wait(uint32_t data, circbuf_spsc_t *ring);
+*   returns             : ERR_SUCCESS for success, or other error
+*   data                : The data to be added
+*   ring                : The buffer to be added to
+* Author                : Ben Heberlein
+* Date                  : 10/17/2026
+* Description           : Add an item, waiting as long as it takes for space
+***********************************************************/
+circbuf_err_t circbuf_spsc_add_wait(uint32_t data, circbuf_spsc_t *ring);
+
+/***********************************************************
+* circbuf_spsc_remove_wait : circbuf_err_t circbuf_spsc_remove_wait(uint32_t *data, circbuf_spsc_t *ring);
+*   returns                : ERR_SUCCESS for success, or other error
+*   data                   : Pointer to where to put data
+*   ring                   : The buffer to get data from
+* Author                   : Ben Heberlein
+* Date                     : 10/17/2026
+* Description              : Remove an item, waiting as long as it takes for one
+***********************************************************/
+circbuf_err_t circbuf_spsc_remove_wait(uint32_t *data, circbuf_spsc_t *ring);
+#endif
 
 #endif
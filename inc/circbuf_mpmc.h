@@ -0,0 +1,113 @@
+/**********************************************************
+* Name: circbuf_mpmc.h
+*
+* Date: 10/17/2026
+*
+* Author: Ben Heberlein
+*
+* Description: This file defines a bounded multi producer,
+* multi consumer circular buffer and associated functions.
+* Every slot carries a sequence number that tells threads
+* whose turn it is, so adding and removing cost one
+* compare and swap on a shared index and no locks.
+*
+**********************************************************/
+
+#ifndef CIRCBUF_MPMC_H
+#define CIRCBUF_MPMC_H
+
+#include <stdint.h>
+#include <stdatomic.h>
+#include "circbuf.h"
+
+/**********************************************************
+* circbuf_mpmc_cell_t
+* Author: Ben Heberlein
+* Date: 10/17/2026
+* Description: One slot of the buffer. seq equals the
+* enqueue position that may fill it next when free, and
+* that position plus one once the data is ready.
+**********************************************************/
+typedef struct circbuf_mpmc_cell {
+
+    _Atomic uint32_t seq;
+    uint32_t data;
+
+} circbuf_mpmc_cell_t;
+
+/**********************************************************
+* circbuf_mpmc_t
+* Author: Ben Heberlein
+* Date: 10/17/2026
+* Description: Multi producer, multi consumer circular
+* buffer. The enqueue and dequeue positions are free
+* running and sit on their own cache lines so producers
+* and consumers only meet in the cells.
+**********************************************************/
+typedef struct circbuf_mpmc {
+
+    circbuf_mpmc_cell_t *cells;
+    uint32_t mask;
+    circbuf_count_t capacity;
+
+    _Alignas(CIRCBUF_CACHE_LINE) _Atomic uint32_t enqueue_pos;
+
+    _Alignas(CIRCBUF_CACHE_LINE) _Atomic uint32_t dequeue_pos;
+
+} circbuf_mpmc_t;
+
+/***********************************************************
+* circbuf_mpmc_allocate : circbuf_err_t circbuf_mpmc_allocate(circbuf_count_t capacity, circbuf_mpmc_t **queue);
+*   returns             : ERR_SUCCESS if successful, or another error if failed
+*   capacity            : Capacity of the buffer, must be a power of two
+*   queue               : Location to put the new buffer
+* Author                : Ben Heberlein
+* Date                  : 10/17/2026
+* Description           : Initialize a new multi producer, multi consumer buffer
+***********************************************************/
+circbuf_err_t circbuf_mpmc_allocate(circbuf_count_t capacity, circbuf_mpmc_t **queue);
+
+/***********************************************************
+* circbuf_mpmc_destroy : circbuf_err_t circbuf_mpmc_destroy(circbuf_mpmc_t *queue);
+*   returns            : ERR_SUCCESS for successful destroy or other error
+*   queue              : Buffer to destroy, must not be in use by any thread
+* Author               : Ben Heberlein
+* Date                 : 10/17/2026
+* Description          : Destroy an existing multi producer, multi consumer buffer
+***********************************************************/
+circbuf_err_t circbuf_mpmc_destroy(circbuf_mpmc_t *queue);
+
+/***********************************************************
+* circbuf_mpmc_add  : circbuf_err_t circbuf_mpmc_add(uint32_t data, circbuf_mpmc_t *queue);
+*   returns         : ERR_SUCCESS for success, ERR_FULL if full, or other error
+*   data            : The data to be added
+*   queue           : The buffer to be added to
+* Author            : Ben Heberlein
+* Date              : 10/17/2026
+* Description       : Add an item, safe to call from any number of threads
+***********************************************************/
+circbuf_err_t circbuf_mpmc_add(uint32_t data, circbuf_mpmc_t *queue);
+
+/***********************************************************
+* circbuf_mpmc_remove : circbuf_err_t circbuf_mpmc_remove(uint32_t *data, circbuf_mpmc_t *queue);
+*   returns           : ERR_SUCCESS for success, ERR_EMPTY if empty, or other error
+*   data              : Pointer to where to put data
+*   queue             : The buffer to get data from
+* Author              : Ben Heberlein
+* Date                : 10/17/2026
+* Description         : Remove an item, safe to call from any number of threads
+***********************************************************/
+circbuf_err_t circbuf_mpmc_remove(uint32_t *data, circbuf_mpmc_t *queue);
+
+/***********************************************************
+* circbuf_mpmc_size  : circbuf_count_t circbuf_mpmc_size(circbuf_mpmc_t *queue);
+*   return           : number of items stored
+*   queue            : Buffer to get size of
+* Author             : Ben Heberlein
+* Date               : 10/17/2026
+* Description        : Returns the size of the buffer. While other threads
+*                      are running the result is only a snapshot.
+***********************************************************/
+circbuf_count_t circbuf_mpmc_size(circbuf_mpmc_t *queue);
+
+#endif
@@ -0,0 +1,240 @@
+/**********************************************************
+* Name: circbuf_shm.h
+*
+* Date: 10/17/2026
+*
+* Author: Ben Heberlein
+*
+* Description: This file defines a single producer, single
+* consumer message channel between processes. The ring
+* lives in POSIX shared memory and is addressed only by
+* byte offsets, so every process can map it at a different
+* address. Messages are variable length frames that are
+* copied straight into the ring, with optional eventfd
+* wakeups for a consumer that wants to sleep.
+*
+**********************************************************/
+
+#ifndef CIRCBUF_SHM_H
+#define CIRCBUF_SHM_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdatomic.h>
+#include "circbuf.h"
+
+/**********************************************************
+* Shared memory channels need POSIX shm and eventfd, so
+* they are only built on Linux hosts.
+**********************************************************/
+#ifdef CIRCBUF_HAVE_WAIT
+#define CIRCBUF_HAVE_SHM
+
+#define CIRCBUF_SHM_MAGIC 0x4d485343u
+#define CIRCBUF_SHM_VERSION 1u
+
+/**********************************************************
+* Every frame starts with an 8 byte header and is padded
+* to 8 bytes. A frame that would run past the end of the
+* ring is preceded by a pad frame that fills the rest of
+* it, so messages are always contiguous.
+**********************************************************/
+#define CIRCBUF_SHM_FRAME_HDR 8u
+#define CIRCBUF_SHM_PAD 0xffffffffu
+
+/**********************************************************
+* circbuf_shm_flag_t
+* Author: Ben Heberlein
+* Date: 10/17/2026
+* Description: Options for circbuf_shm_create. With
+* CIRCBUF_SHM_EVENTFD the timed calls sleep on an eventfd
+* instead of polling, and every send and receive pays for
+* one full fence to check if the other side is asleep.
+**********************************************************/
+typedef enum circbuf_shm_flag {
+
+    CIRCBUF_SHM_EVENTFD = 0x01
+
+} circbuf_shm_flag_t;
+
+/**********************************************************
+* circbuf_shm_hdr_t
+* Author: Ben Heberlein
+* Date: 10/17/2026
+* Description: Start of the shared memory object. head
+* and tail are free running byte counts, not pointers, and
+* the data area is found at data_offset from the start of
+* the mapping. Each waiting flag sits in the line of the
+* side that has to check it.
+**********************************************************/
+typedef struct circbuf_shm_hdr {
+
+    uint32_t magic;
+    uint32_t version;
+    uint64_t capacity;
+    uint64_t data_offset;
+    uint32_t flags;
+    uint32_t reserved;
+
+    // Written by the producer
+    _Alignas(CIRCBUF_CACHE_LINE) _Atomic uint64_t head;
+    _Atomic uint32_t cons_waiting;
+
+    // Written by the consumer
+    _Alignas(CIRCBUF_CACHE_LINE) _Atomic uint64_t tail;
+    _Atomic uint32_t prod_waiting;
+
+} circbuf_shm_hdr_t;
+
+/**********************************************************
+* circbuf_shm_t
+* Author: Ben Heberlein
+* Date: 10/17/2026
+* Description: One process's handle on a channel. The
+* cached positions save a shared cache line read on most
+* calls. data_fd is signalled when a message arrives and
+* space_fd when one is taken out, both are -1 when not in
+* use.
+**********************************************************/
+typedef struct circbuf_shm {
+
+    circbuf_shm_hdr_t *hdr;
+    uint8_t *data;
+    size_t map_len;
+    uint64_t mask;
+    uint64_t head_cache;
+    uint64_t tail_cache;
+    uint32_t spin;
+    int data_fd;
+    int space_fd;
+
+} circbuf_shm_t;
+
+/***********************************************************
+* circbuf_shm_create : circbuf_err_t circbuf_shm_create(const char *name, size_t capacity, uint32_t flags, circbuf_shm_t **channel);
+*   returns          : ERR_SUCCESS if successful, or another error if failed
+*   name             : POSIX shared memory name, like "/my_channel"
+*   capacity         : Bytes in the ring, a power of two of at least 64
+*   flags            : Or of circbuf_shm_flag_t values
+*   channel          : Location to put the new handle
+* Author             : Ben Heberlein
+* Date               : 10/17/2026
+* Description        : Create a new channel. Fails if the name is already in
+*                      use. The eventfds of a CIRCBUF_SHM_EVENTFD channel
+*                      are shared with children made by fork, other
+*                      processes have to be given them with
+*                      circbuf_shm_set_eventfd.
+***********************************************************/
+circbuf_err_t circbuf_shm_create(const char *name, size_t capacity, uint32_t flags,
+                                 circbuf_shm_t **channel);
+
+/***********************************************************
+* circbuf_shm_open   : circbuf_err_t circbuf_shm_open(const char *name, circbuf_shm_t **channel);
+*   returns          : ERR_SUCCESS if successful, or another error if failed
+*   name             : Name the channel was created with
+*   channel          : Location to put the new handle
+* Author             : Ben Heberlein
+* Date               : 10/17/2026
+* Description        : Open a channel made by another process
+***********************************************************/
+circbuf_err_t circbuf_shm_open(const char *name, circbuf_shm_t **channel);
+
+/***********************************************************
+* circbuf_shm_close  : circbuf_err_t circbuf_shm_close(circbuf_shm_t *channel);
+*   returns          : ERR_SUCCESS for successful close or other error
+*   channel          : Handle to close
+* Author             : Ben Heberlein
+* Date               : 10/17/2026
+* Description        : Unmap the channel and close its eventfds. The shared
+*                      memory object stays until circbuf_shm_unlink.
+***********************************************************/
+circbuf_err_t circbuf_shm_close(circbuf_shm_t *channel);
+
+/***********************************************************
+* circbuf_shm_unlink : circbuf_err_t circbuf_shm_unlink(const char *name);
+*   returns          : ERR_SUCCESS if successful, or another error if failed
+*   name             : Name the channel was created with
+* Author             : Ben Heberlein
+* Date               : 10/17/2026
+* Description        : Remove the name. Open handles keep working.
+***********************************************************/
+circbuf_err_t circbuf_shm_unlink(const char *name);
+
+/***********************************************************
+* circbuf_shm_set_eventfd : circbuf_err_t circbuf_shm_set_eventfd(circbuf_shm_t *channel, int data_fd, int space_fd);
+*   returns               : ERR_SUCCESS if successful, or another error if failed
+*   channel               : Handle opened with circbuf_shm_open
+*   data_fd               : The creator's data eventfd
+*   space_fd              : The creator's space eventfd
+* Author                  : Ben Heberlein
+* Date                    : 10/17/2026
+* Description             : Give a handle the eventfds of a CIRCBUF_SHM_EVENTFD
+*                           channel, usually received over a unix socket. The
+*                           handle owns them from then on.
+***********************************************************/
+circbuf_err_t circbuf_shm_set_eventfd(circbuf_shm_t *channel, int data_fd, int space_fd);
+
+/***********************************************************
+* circbuf_shm_send   : circbuf_err_t circbuf_shm_send(circbuf_shm_t *channel, const void *msg, size_t len);
+*   returns          : ERR_SUCCESS for success, ERR_FULL if there is no room,
+*                      ERR_CONFIG if len is over capacity / 2 - 8, or other error
+*   channel          : The channel to send on
+*   msg              : Message bytes
+*   len              : Length of the message, may be 0
+* Author             : Ben Heberlein
+* Date               : 10/17/2026
+* Description        : Copy a message into the ring without waiting. May only
+*                      be called from the producer process.
+***********************************************************/
+circbuf_err_t circbuf_shm_send(circbuf_shm_t *channel, const void *msg, size_t len);
+
+/***********************************************************
+* circbuf_shm_recv   : circbuf_err_t circbuf_shm_recv(circbuf_shm_t *channel, void *buf, size_t size, size_t *len);
+*   returns          : ERR_SUCCESS for success, ERR_EMPTY if there is no message,
+*                      ERR_MEM if buf is too small, or other error
+*   channel          : The channel to receive from
+*   buf              : Where to put the message
+*   size             : Size of buf
+*   len              : Set to the message length, also when buf is too small
+* Author             : Ben Heberlein
+* Date               : 10/17/2026
+* Description        : Copy the next message out of the ring without waiting.
+*                      A message that does not fit stays in the ring. May only
+*                      be called from the consumer process.
+***********************************************************/
+circbuf_err_t circbuf_shm_recv(circbuf_shm_t *channel, void *buf, size_t size, size_t *len);
+
+/***********************************************************
+* circbuf_shm_send_timed : circbuf_err_t circbuf_shm_send_timed(circbuf_shm_t *channel, const void *msg, size_t len, uint64_t timeout_ns);
+*   returns              : ERR_SUCCESS for success, ERR_FULL on timeout, or other error
+*   channel              : The channel to send on
+*   msg                  : Message bytes
+*   len                  : Length of the message
+*   timeout_ns           : Longest time to wait in nanoseconds, or CIRCBUF_WAIT_FOREVER
+* Author                 : Ben Heberlein
+* Date                   : 10/17/2026
+* Description            : Send a message, waiting for room. Spins for a short,
+*                          adaptive time, then sleeps on the space eventfd if
+*                          there is one and yields the CPU if not.
+***********************************************************/
+circbuf_err_t circbuf_shm_send_timed(circbuf_shm_t *channel, const void *msg, size_t len,
+                                     uint64_t timeout_ns);
+
+/***********************************************************
+* circbuf_shm_recv_timed : circbuf_err_t circbuf_shm_recv_timed(circbuf_shm_t *channel, void *buf, size_t size, size_t *len, uint64_t timeout_ns);
+*   returns              : ERR_SUCCESS for success, ERR_EMPTY on timeout, or other error
+*   channel              : The channel to receive from
+*   buf                  : Where to put the message
+*   size                 : Size of buf
+*   len                  : Set to the message length
+*   timeout_ns           : Longest time to wait in nanoseconds, or CIRCBUF_WAIT_FOREVER
+* Author                 : Ben Heberlein
+* Date                   : 10/17/2026
+* Description            : Receive a message, waiting for one to arrive. Waits
+*                          the same way as circbuf_shm_send_timed.
+***********************************************************/
+circbuf_err_t circbuf_shm_recv_timed(circbuf_shm_t *channel, void *buf, size_t size, size_t *len,
+                                     uint64_t timeout_ns);
+
+#endif
+#endif
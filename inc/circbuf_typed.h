@@ -0,0 +1,154 @@
+/**********************************************************
+* Name: circbuf_typed.h
+*
+* Date: 10/17/2026
+*
+* Author: Ben Heberlein
+*
+* Description: This file defines a generator for circular
+* buffers of any element type with a capacity fixed at
+* compile time. Every function is static inline and the
+* capacity is a power of two constant, so wrapping is a
+* constant mask and element copies are a fixed size the
+* compiler can inline and vectorize.
+*
+* Usage:
+*   CIRCBUF_DEFINE(sample, struct sample, 256)
+*
+* emits the type circbuf_sample_t and the functions
+* circbuf_sample_init, circbuf_sample_add,
+* circbuf_sample_remove, circbuf_sample_add_n,
+* circbuf_sample_remove_n, circbuf_sample_is_full,
+* circbuf_sample_is_empty and circbuf_sample_size, which
+* behave like their circbuf_t counterparts.
+*
+**********************************************************/
+
+#ifndef CIRCBUF_TYPED_H
+#define CIRCBUF_TYPED_H
+
+#include <stdint.h>
+#include <string.h>
+#include "circbuf.h"
+
+/**********************************************************
+* CIRCBUF_DEFINE(name, type, cap)
+*   name : Suffix for the generated type and functions
+*   type : Element type stored in the buffer
+*   cap  : Capacity, must be a power of two constant
+* Author: Ben Heberlein
+* Date: 10/17/2026
+* Description: Emit a typed circular buffer. The buffer
+* memory lives inside the struct, so it can be declared
+* statically or on the stack without any allocation.
+**********************************************************/
+#define CIRCBUF_DEFINE(name, type, cap)                                        \
+                                                                               \
+_Static_assert((cap) > 0 && ((cap) & ((cap) - 1)) == 0,                        \
+               "circbuf_" #name " capacity must be a power of two");           \
+                                                                               \
+typedef struct circbuf_##name {                                                \
+    uint32_t in;                                                               \
+    uint32_t out;                                                              \
+    type buf[cap];                                                             \
+} circbuf_##name##_t;                                                          \
+                                                                               \
+static inline circbuf_err_t circbuf_##name##_init(circbuf_##name##_t *cb) {    \
+    if (cb == NULL) {                                                          \
+        return ERR_NULLPTR;                                                    \
+    }                                                                          \
+    cb->in = 0;                                                                \
+    cb->out = 0;                                                               \
+    return ERR_SUCCESS;                                                        \
+}                                                                              \
+                                                                               \
+static inline circbuf_err_t circbuf_##name##_is_full(circbuf_##name##_t *cb) { \
+    if (cb == NULL) {                                                          \
+        return ERR_NULLPTR;                                                    \
+    }                                                                          \
+    return (cb->in - cb->out == (cap)) ? ERR_FULL : ERR_PARTIAL;               \
+}                                                                              \
+                                                                               \
+static inline circbuf_err_t circbuf_##name##_is_empty(circbuf_##name##_t *cb) {\
+    if (cb == NULL) {                                                          \
+        return ERR_NULLPTR;                                                    \
+    }                                                                          \
+    return (cb->in == cb->out) ? ERR_EMPTY : ERR_PARTIAL;                      \
+}                                                                              \
+                                                                               \
+static inline circbuf_count_t circbuf_##name##_size(circbuf_##name##_t *cb) {  \
+    if (cb == NULL) {                                                          \
+        return 0;                                                              \
+    }                                                                          \
+    return (circbuf_count_t) (cb->in - cb->out);                               \
+}                                                                              \
+                                                                               \
+static inline circbuf_err_t circbuf_##name##_add(type data,                     \
+                                                 circbuf_##name##_t *cb) {     \
+    if (cb == NULL) {                                                          \
+        return ERR_NULLPTR;                                                    \
+    }                                                                          \
+    if (cb->in - cb->out == (cap)) {                                           \
+        return ERR_FULL;                                                       \
+    }                                                                          \
+    cb->buf[cb->in & ((cap) - 1)] = data;                                      \
+    cb->in++;                                                                  \
+    return ERR_SUCCESS;                                                        \
+}                                                                              \
+                                                                               \
+static inline circbuf_err_t circbuf_##name##_remove(type *data,                \
+                                                    circbuf_##name##_t *cb) {  \
+    if (cb == NULL || data == NULL) {                                          \
+        return ERR_NULLPTR;                                                    \
+    }                                                                          \
+    if (cb->in == cb->out) {                                                   \
+        return ERR_EMPTY;                                                      \
+    }                                                                          \
+    *data = cb->buf[cb->out & ((cap) - 1)];                                    \
+    cb->out++;                                                                 \
+    return ERR_SUCCESS;                                                        \
+}                                                                              \
+                                                                               \
+static inline circbuf_count_t circbuf_##name##_add_n(const type *data,         \
+                                                     circbuf_count_t count,    \
+                                                     circbuf_##name##_t *cb) { \
+    if (cb == NULL || data == NULL) {                                          \
+        return 0;                                                              \
+    }                                                                          \
+    circbuf_count_t n = (cap) - (cb->in - cb->out);                            \
+    if (count < n) {                                                           \
+        n = count;                                                             \
+    }                                                                          \
+    uint32_t head = cb->in & ((cap) - 1);                                      \
+    circbuf_count_t first = (cap) - head;                                      \
+    if (first > n) {                                                           \
+        first = n;                                                             \
+    }                                                                          \
+    memcpy(&cb->buf[head], data, first * sizeof(type));                        \
+    memcpy(&cb->buf[0], data + first, (n - first) * sizeof(type));             \
+    cb->in += (uint32_t) n;                                                    \
+    return n;                                                                  \
+}                                                                              \
+                                                                               \
+static inline circbuf_count_t circbuf_##name##_remove_n(type *data,            \
+                                                        circbuf_count_t count, \
+                                                        circbuf_##name##_t *cb) { \
+    if (cb == NULL || data == NULL) {                                          \
+        return 0;                                                              \
+    }                                                                          \
+    circbuf_count_t n = cb->in - cb->out;                                      \
+    if (count < n) {                                                           \
+        n = count;                                                             \
+    }                                                                          \
+    uint32_t tail = cb->out & ((cap) - 1);                                     \
+    circbuf_count_t first = (cap) - tail;                                      \
+    if (first > n) {                                                           \
+        first = n;                                                             \
+    }                                                                          \
+    memcpy(data, &cb->buf[tail], first * sizeof(type));                        \
+    memcpy(data + first, &cb->buf[0], (n - first) * sizeof(type));             \
+    cb->out += (uint32_t) n;                                                   \
+    return n;                                                                  \
+}
+
+#endif
@@ -26,8 +26,16 @@
 #ifndef __LL2_H__
 #define __LL2_H__
 
+#include <stddef.h>
 #include <stdint.h>
 
+/**
+ * @brief Number of nodes in each slab a heap backed pool allocates
+ */
+#ifndef LL2_POOL_SLAB_NODES
+#define LL2_POOL_SLAB_NODES 64
+#endif
+
 /**
  * @brief Structure for a node
  */
@@ -37,6 +45,59 @@ typedef struct ll2_node_s {
     uint32_t data;
 } ll2_node_t;
 
+/**
+ * @brief Node pool for one list
+ *
+ * Nodes are carved in order out of the current slab and freed nodes go on a
+ * free list, so getting or returning a node is O(1). A heap backed pool
+ * mallocs a slab of LL2_POOL_SLAB_NODES nodes when it runs out, an arena
+ * backed pool only ever uses the caller's memory. Slabs are kept until the
+ * pool is destroyed, so a list that is emptied and rebuilt makes no calls to
+ * the system allocator.
+ */
+typedef struct ll2_pool_s {
+    ll2_node_t *free_list;
+    ll2_node_t *next_node;
+    ll2_node_t *end;
+    struct ll2_slab_s *slabs;
+    struct ll2_slab_s *cur;
+    ll2_node_t *arena;
+    size_t arena_nodes;
+} ll2_pool_t;
+
+/**
+ * @brief List handle that tracks both ends and the length
+ *
+ * Keeping the tail and count next to the head makes size, push_back and
+ * pop_back O(1), and indexed access walks from whichever end is closer. The
+ * list owns its nodes, and takes them from pool if it has one. lookup is the
+ * optional value index from ll2_list_index_enable.
+ */
+typedef struct ll2_list_s {
+    ll2_node_t *head;
+    ll2_node_t *tail;
+    size_t count;
+    ll2_pool_t *pool;
+    struct ll2_index_s *lookup;
+} ll2_list_t;
+
+/**
+ * @brief Position in a list between prev and the node after it
+ *
+ * The cursor is at the node after prev, or at the head when prev is NULL,
+ * and index counts the nodes before it. At the end of the list that node is
+ * NULL and index equals the size. list is set for cursors over a list handle,
+ * whose size, tail and value index are then kept up to date. Changing the
+ * list other than through the cursor leaves the cursor invalid.
+ */
+typedef struct ll2_cursor_s {
+    ll2_node_t **head;
+    ll2_list_t *list;
+    ll2_pool_t *pool;
+    ll2_node_t *prev;
+    size_t index;
+} ll2_cursor_t;
+
 /**
  * @brief Enum for linked list error codes
  */
@@ -120,4 +181,531 @@ ll2_err_t ll2_search(ll2_node_t **head, uint32_t data, uint16_t *index);
  */
 uint16_t ll2_size(ll2_node_t **head); 
 
+/**
+ * @brief Sets up a node pool
+ * 
+ * This function prepares a pool to hand out nodes for one list. If arena is
+ * NULL, the pool grows in slabs taken from the heap. Otherwise all nodes are
+ * carved out of the size bytes at arena, and adding to a list fails with
+ * LL2_MEM once they are used up. Returns LL2_SUCCESS for successful
+ * operation.
+ * 
+ * @param pool The pool to set up
+ * @param arena Caller owned memory for the nodes, or NULL to use the heap
+ * @param size The number of bytes at arena
+ *
+ * @return A status code of type ll2_err_t
+ */
+ll2_err_t ll2_pool_init(ll2_pool_t *pool, void *arena, size_t size);
+
+/**
+ * @brief Releases all memory held by a node pool
+ * 
+ * This function frees every slab of a heap backed pool. Nodes from the pool
+ * must not be used after this call, and the pool must be set up again with
+ * ll2_pool_init before it is reused. An arena is left to the caller. Returns
+ * LL2_SUCCESS for successful operation.
+ * 
+ * @param pool The pool to release
+ *
+ * @return A status code of type ll2_err_t
+ */
+ll2_err_t ll2_pool_destroy(ll2_pool_t *pool);
+
+/**
+ * @brief Destroys a list whose nodes all come from one pool
+ * 
+ * This function drops every node in the list in one step by resetting the
+ * pool instead of walking the list, so it takes the same time for any list
+ * length. The pool keeps its slabs for the next list. The pool must not hold
+ * nodes of any other list. Returns LL2_SUCCESS for successful operation.
+ * 
+ * @param head A double pointer to the linked list head
+ * @param pool The pool the list was built from
+ *
+ * @return A status code of type ll2_err_t
+ */
+ll2_err_t ll2_destroy_pool(ll2_node_t **head, ll2_pool_t *pool);
+
+/**
+ * @brief Adds a node taken from a pool to the list at the specified index
+ * 
+ * This function works like ll2_add_node, but takes the new node from pool.
+ * A NULL pool uses malloc, which is what ll2_add_node does. Returns LL2_MEM
+ * if the pool has no memory left.
+ * 
+ * @param head A double pointer to the linked list head
+ * @param data The data that should be inserted
+ * @param index The index to insert at
+ * @param pool The pool the list is built from, or NULL
+ *
+ * @return A status code of type ll2_err_t
+ */
+ll2_err_t ll2_add_node_pool(ll2_node_t **head, uint32_t data, uint16_t index, ll2_pool_t *pool);
+
+/**
+ * @brief Removes a node at the specified index and returns it to a pool
+ * 
+ * This function works like ll2_remove_node, but gives the node back to pool.
+ * A NULL pool uses free, which is what ll2_remove_node does.
+ * 
+ * @param head A double pointer to the linked list head
+ * @param index the index that should be deleted
+ * @param pool The pool the list is built from, or NULL
+ *
+ * @return A status code of type ll2_err_t
+ */
+ll2_err_t ll2_remove_node_pool(ll2_node_t **head, uint16_t index, ll2_pool_t *pool);
+
+/**
+ * @brief Adds an array of values to the list starting at the specified index
+ * 
+ * This function walks to index once, builds a run of count nodes and splices
+ * the whole run in, so values[0] ends up at index. This costs O(index + count)
+ * instead of count separate walks. If the list is not long enough, the
+ * function returns LL2_INDEX. If a node can not be allocated, nothing is
+ * added and the function returns LL2_MEM.
+ * 
+ * @param head A double pointer to the linked list head
+ * @param values The values to insert, in order
+ * @param count The number of values
+ * @param index The index to insert at
+ *
+ * @return A status code of type ll2_err_t
+ */
+ll2_err_t ll2_insert_array(ll2_node_t **head, const uint32_t *values, size_t count, uint16_t index);
+
+/**
+ * @brief Adds an array of values taken from a pool to the list
+ * 
+ * This function works like ll2_insert_array, but takes the new nodes from
+ * pool, where they are carved from the same slab one after another. A NULL
+ * pool uses malloc.
+ * 
+ * @param head A double pointer to the linked list head
+ * @param values The values to insert, in order
+ * @param count The number of values
+ * @param index The index to insert at
+ * @param pool The pool the list is built from, or NULL
+ *
+ * @return A status code of type ll2_err_t
+ */
+ll2_err_t ll2_insert_array_pool(ll2_node_t **head, const uint32_t *values, size_t count, uint16_t index,
+                                ll2_pool_t *pool);
+
+/**
+ * @brief Removes a run of nodes starting at the specified index
+ * 
+ * This function walks to start once, cuts count nodes out in one step and
+ * frees them. If the list does not hold count nodes from start, nothing is
+ * removed and the function returns LL2_INDEX.
+ * 
+ * @param head A double pointer to the linked list head
+ * @param start The index of the first node to delete
+ * @param count The number of nodes to delete
+ *
+ * @return A status code of type ll2_err_t
+ */
+ll2_err_t ll2_remove_range(ll2_node_t **head, uint16_t start, size_t count);
+
+/**
+ * @brief Removes a run of nodes and returns them to a pool
+ * 
+ * This function works like ll2_remove_range, but gives the nodes back to
+ * pool. A NULL pool uses free.
+ * 
+ * @param head A double pointer to the linked list head
+ * @param start The index of the first node to delete
+ * @param count The number of nodes to delete
+ * @param pool The pool the list is built from, or NULL
+ *
+ * @return A status code of type ll2_err_t
+ */
+ll2_err_t ll2_remove_range_pool(ll2_node_t **head, uint16_t start, size_t count, ll2_pool_t *pool);
+
+/**
+ * @brief Sorts the list by data in O(n log n)
+ * 
+ * This function runs a bottom-up merge sort that relinks the existing nodes,
+ * so nothing is allocated or copied. Nodes with equal data keep their order.
+ * 
+ * @param head A double pointer to the linked list head
+ *
+ * @return A status code of type ll2_err_t
+ */
+ll2_err_t ll2_sort(ll2_node_t **head);
+
+/**
+ * @brief Adds data to a sorted list so that it stays sorted
+ * 
+ * This function walks the list once and adds data after the last node that
+ * is not greater, so equal values keep the order they were added in. It
+ * replaces ll2_search followed by ll2_add_node, which walks twice.
+ * 
+ * @param head A double pointer to the linked list head
+ * @param data The data that should be inserted
+ *
+ * @return A status code of type ll2_err_t
+ */
+ll2_err_t ll2_add_sorted(ll2_node_t **head, uint32_t data);
+
+/**
+ * @brief Adds data to a sorted list from a pool
+ * 
+ * This function works like ll2_add_sorted, but takes the node from pool. A
+ * NULL pool uses malloc.
+ * 
+ * @param head A double pointer to the linked list head
+ * @param data The data that should be inserted
+ * @param pool The pool to take the node from, or NULL
+ *
+ * @return A status code of type ll2_err_t
+ */
+ll2_err_t ll2_add_sorted_pool(ll2_node_t **head, uint32_t data, ll2_pool_t *pool);
+
+/**
+ * @brief Merges one sorted list into another in O(n + m)
+ * 
+ * This function relinks the nodes of src into dst so that dst stays sorted,
+ * and leaves src empty. Where values are equal the nodes of dst come first.
+ * Both lists must take their nodes from the same place, the heap or one
+ * pool, since dst frees them all together later.
+ * 
+ * @param dst A double pointer to the head of the list to merge into
+ * @param src A double pointer to the head of the list to merge from
+ *
+ * @return A status code of type ll2_err_t
+ */
+ll2_err_t ll2_merge(ll2_node_t **dst, ll2_node_t **src);
+
+/**
+ * @brief Sets up an empty list handle
+ * 
+ * This function prepares a list handle. If pool is not NULL, every node of
+ * the list comes from it and the pool must not be shared with another list.
+ * Returns LL2_SUCCESS for successful operation.
+ * 
+ * @param list The list to set up
+ * @param pool The node pool for the list, or NULL to use malloc
+ *
+ * @return A status code of type ll2_err_t
+ */
+ll2_err_t ll2_list_init(ll2_list_t *list, ll2_pool_t *pool);
+
+/**
+ * @brief Destroys all nodes in the list
+ * 
+ * This function releases every node and leaves the list empty and ready for
+ * reuse. A pooled list is released in one step with ll2_destroy_pool. Returns
+ * LL2_SUCCESS for successful operation.
+ * 
+ * @param list The list to destroy
+ *
+ * @return A status code of type ll2_err_t
+ */
+ll2_err_t ll2_list_destroy(ll2_list_t *list);
+
+/**
+ * @brief Adds data to the list at the specified index
+ * 
+ * This function adds data so that it ends up at index. An index equal to the
+ * size appends in O(1). If the index is past the end, the function returns
+ * LL2_INDEX. If no node can be allocated, it returns LL2_MEM.
+ * 
+ * @param list The list to add to
+ * @param data The data that should be inserted
+ * @param index The index to insert at
+ *
+ * @return A status code of type ll2_err_t
+ */
+ll2_err_t ll2_list_add(ll2_list_t *list, uint32_t data, size_t index);
+
+/**
+ * @brief Removes the node at the specified index
+ * 
+ * This function removes the node at index. If the index is out of bounds,
+ * the function returns LL2_INDEX.
+ * 
+ * @param list The list to remove from
+ * @param index The index that should be deleted
+ *
+ * @return A status code of type ll2_err_t
+ */
+ll2_err_t ll2_list_remove(ll2_list_t *list, size_t index);
+
+/**
+ * @brief Adds an array of values to the list starting at the specified index
+ * 
+ * This function works like ll2_insert_array and keeps the size, tail and
+ * value index of the handle up to date. The walk starts from the closer end.
+ * If the index is past the end, the function returns LL2_INDEX. If memory
+ * runs out, nothing is added and the function returns LL2_MEM.
+ * 
+ * @param list The list to add to
+ * @param values The values to insert, in order
+ * @param count The number of values
+ * @param index The index to insert at
+ *
+ * @return A status code of type ll2_err_t
+ */
+ll2_err_t ll2_list_insert_array(ll2_list_t *list, const uint32_t *values, size_t count, size_t index);
+
+/**
+ * @brief Removes a run of nodes starting at the specified index
+ * 
+ * This function works like ll2_remove_range and keeps the size, tail and
+ * value index of the handle up to date. If the list does not hold count
+ * nodes from start, nothing is removed and the function returns LL2_INDEX.
+ * 
+ * @param list The list to remove from
+ * @param start The index of the first node to delete
+ * @param count The number of nodes to delete
+ *
+ * @return A status code of type ll2_err_t
+ */
+ll2_err_t ll2_list_remove_range(ll2_list_t *list, size_t start, size_t count);
+
+/**
+ * @brief Sorts the list by data in O(n log n)
+ * 
+ * This function works like ll2_sort and keeps the tail and value index of
+ * the handle up to date.
+ * 
+ * @param list The list to sort
+ *
+ * @return A status code of type ll2_err_t
+ */
+ll2_err_t ll2_list_sort(ll2_list_t *list);
+
+/**
+ * @brief Adds data to a sorted list so that it stays sorted
+ * 
+ * This function walks back from the tail, so data that arrives mostly in
+ * order is added in close to O(1). Equal values keep the order they were
+ * added in. If the node can not be allocated, the function returns LL2_MEM.
+ * 
+ * @param list The list to add to
+ * @param data The data that should be inserted
+ *
+ * @return A status code of type ll2_err_t
+ */
+ll2_err_t ll2_list_add_sorted(ll2_list_t *list, uint32_t data);
+
+/**
+ * @brief Merges one sorted list into another in O(n + m)
+ * 
+ * This function works like ll2_merge and keeps the size, tail and value
+ * index of both handles up to date. Handles with pools can not be merged,
+ * since a pool belongs to one list, and the function returns LL2_OTHER.
+ * 
+ * @param dst The list to merge into
+ * @param src The list to merge from, left empty
+ *
+ * @return A status code of type ll2_err_t
+ */
+ll2_err_t ll2_list_merge(ll2_list_t *dst, ll2_list_t *src);
+
+/**
+ * @brief Appends data to the end of the list in O(1)
+ * 
+ * @param list The list to add to
+ * @param data The data that should be appended
+ *
+ * @return A status code of type ll2_err_t
+ */
+ll2_err_t ll2_list_push_back(ll2_list_t *list, uint32_t data);
+
+/**
+ * @brief Removes the last node of the list in O(1)
+ * 
+ * This function returns the data of the last node through data and removes
+ * the node. If the list is empty, the function returns LL2_INDEX.
+ * 
+ * @param list The list to remove from
+ * @param data A pointer to return the data of the removed node
+ *
+ * @return A status code of type ll2_err_t
+ */
+ll2_err_t ll2_list_pop_back(ll2_list_t *list, uint32_t *data);
+
+/**
+ * @brief Searches the list for data
+ * 
+ * This function returns the index of the first node holding data through the
+ * index pointer and returns LL2_SUCCESS. If the data is not found, the
+ * function returns LL2_DATA.
+ * 
+ * @param list The list to search
+ * @param data The data to search for in the list
+ * @param index A pointer to return the index of the data
+ *
+ * @return A status code of type ll2_err_t
+ */
+ll2_err_t ll2_list_search(ll2_list_t *list, uint32_t data, size_t *index);
+
+/**
+ * @brief Returns the size of the list in O(1)
+ * 
+ * @param list The list to get the size of
+ *
+ * @return The number of nodes in the list
+ */
+size_t ll2_list_size(ll2_list_t *list);
+
+/**
+ * @brief Adds a value index to the list
+ * 
+ * This function builds a hash index of the nodes in the list. From then on
+ * the list keeps it up to date on every add and remove, ll2_list_search and
+ * ll2_list_locate take expected O(1) time, and adding costs one hash insert.
+ * Positions found by ll2_list_search are renumbered in one pass after an add
+ * or remove anywhere but the tail. Data must not be changed in place while
+ * the index is on. Returns LL2_MEM if the index can not be allocated.
+ * 
+ * @param list The list to index
+ *
+ * @return A status code of type ll2_err_t
+ */
+ll2_err_t ll2_list_index_enable(ll2_list_t *list);
+
+/**
+ * @brief Removes the value index from the list and frees it
+ * 
+ * This function must be called before the list handle is dropped if the
+ * index was enabled. ll2_list_destroy keeps the index for the next use.
+ * 
+ * @param list The list to stop indexing
+ *
+ * @return A status code of type ll2_err_t
+ */
+ll2_err_t ll2_list_index_disable(ll2_list_t *list);
+
+/**
+ * @brief Finds a node holding data
+ * 
+ * This function returns a node holding data through the node pointer and
+ * returns LL2_SUCCESS, or returns LL2_DATA if there is none. With an index
+ * this takes expected O(1) time, and any of several equal nodes may come
+ * back. Without one it is the first such node.
+ * 
+ * @param list The list to search
+ * @param data The data to search for in the list
+ * @param node A pointer to return the node
+ *
+ * @return A status code of type ll2_err_t
+ */
+ll2_err_t ll2_list_locate(ll2_list_t *list, uint32_t data, ll2_node_t **node);
+
+/**
+ * @brief Sets up a cursor at the head of a list
+ * 
+ * This function points the cursor at index 0 of the list starting at head.
+ * Nodes added through the cursor come from pool, and removed ones go back
+ * to it. A NULL pool uses malloc and free.
+ * 
+ * @param cursor The cursor to set up
+ * @param head A double pointer to the linked list head
+ * @param pool The pool the list is built from, or NULL
+ *
+ * @return A status code of type ll2_err_t
+ */
+ll2_err_t ll2_cursor_init(ll2_cursor_t *cursor, ll2_node_t **head, ll2_pool_t *pool);
+
+/**
+ * @brief Sets up a cursor at an index of a list handle
+ * 
+ * This function walks from the closer end to index, which may equal the size
+ * to start at the end. If the index is past the end, the function returns
+ * LL2_INDEX.
+ * 
+ * @param cursor The cursor to set up
+ * @param list The list to move over
+ * @param index The index to start at
+ *
+ * @return A status code of type ll2_err_t
+ */
+ll2_err_t ll2_list_cursor_init(ll2_cursor_t *cursor, ll2_list_t *list, size_t index);
+
+/**
+ * @brief Moves the cursor one node towards the tail in O(1)
+ * 
+ * If the cursor is already at the end, the function returns LL2_INDEX.
+ * 
+ * @param cursor The cursor to move
+ *
+ * @return A status code of type ll2_err_t
+ */
+ll2_err_t ll2_cursor_next(ll2_cursor_t *cursor);
+
+/**
+ * @brief Moves the cursor one node towards the head in O(1)
+ * 
+ * If the cursor is already at the head, the function returns LL2_INDEX.
+ * 
+ * @param cursor The cursor to move
+ *
+ * @return A status code of type ll2_err_t
+ */
+ll2_err_t ll2_cursor_prev(ll2_cursor_t *cursor);
+
+/**
+ * @brief Reads the data of the node at the cursor
+ * 
+ * If the cursor is at the end, the function returns LL2_INDEX.
+ * 
+ * @param cursor The cursor to read at
+ * @param data A pointer to return the data
+ *
+ * @return A status code of type ll2_err_t
+ */
+ll2_err_t ll2_cursor_get(ll2_cursor_t *cursor, uint32_t *data);
+
+/**
+ * @brief Returns the index of the cursor
+ * 
+ * @param cursor The cursor to read
+ *
+ * @return The number of nodes before the cursor
+ */
+size_t ll2_cursor_index(ll2_cursor_t *cursor);
+
+/**
+ * @brief Adds data in front of the node at the cursor in O(1)
+ * 
+ * The cursor stays on the same node, so its index goes up by one. At the end
+ * of the list this appends. If no node can be allocated, the function
+ * returns LL2_MEM.
+ * 
+ * @param cursor The cursor to insert at
+ * @param data The data that should be inserted
+ *
+ * @return A status code of type ll2_err_t
+ */
+ll2_err_t ll2_cursor_insert_before(ll2_cursor_t *cursor, uint32_t data);
+
+/**
+ * @brief Adds data after the node at the cursor in O(1)
+ * 
+ * The cursor does not move. If the cursor is at the end, the function
+ * returns LL2_INDEX. If no node can be allocated, it returns LL2_MEM.
+ * 
+ * @param cursor The cursor to insert at
+ * @param data The data that should be inserted
+ *
+ * @return A status code of type ll2_err_t
+ */
+ll2_err_t ll2_cursor_insert_after(ll2_cursor_t *cursor, uint32_t data);
+
+/**
+ * @brief Removes the node at the cursor in O(1)
+ * 
+ * The cursor moves on to the node that followed, at the same index. If the
+ * cursor is at the end, the function returns LL2_INDEX.
+ * 
+ * @param cursor The cursor to remove at
+ *
+ * @return A status code of type ll2_err_t
+ */
+ll2_err_t ll2_cursor_remove(ll2_cursor_t *cursor);
+
 #endif /* __LL2_H__ */
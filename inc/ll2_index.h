@@ -0,0 +1,156 @@
+/*******************************************************************************
+* Copyright (C) 2017 by Ben Heberlein
+*
+* Redistribution, modification or use of this software in source or binary
+* forms is permitted as long as the files maintain this copyright. This file
+* was created for the University of Colorado Boulder course Advanced Practical
+* Embedded Software Development. Ben Heberlein and the University of Colorado
+* are not liable for any misuse of this material.
+*
+*******************************************************************************/
+/**
+ * @file ll2_index.h
+ * @brief The interface for the ll2 value index
+ *
+ * This header file provides an open addressing hash table from data values to
+ * the nodes that hold them. A list handle with an index keeps it up to date on
+ * every add and remove, so membership and locating a node take expected O(1)
+ * time. Each distinct value has one entry, so a list full of equal values
+ * does not make the probe runs of other values longer. Each entry also caches
+ * the position of the first node holding its value. Positions are
+ * renumbered in one pass the first time they are needed after an insert or
+ * remove in the middle of the list, and appends and pops at the tail keep
+ * them valid.
+ *
+ * @author Ben Heberlein
+ * @date October 17 2026
+ * @version 1.0
+ *
+ */
+
+#ifndef __LL2_INDEX_H__
+#define __LL2_INDEX_H__
+
+#include <stddef.h>
+#include <stdint.h>
+#include "ll2.h"
+
+/**
+ * @brief One slot of the table, empty when node is NULL
+ *
+ * node is one of the nodes holding key and the other extra of them are kept
+ * in more, which has room for room nodes.
+ */
+typedef struct ll2_index_entry_s {
+    ll2_node_t *node;
+    ll2_node_t **more;
+    size_t extra;
+    size_t room;
+    size_t pos;
+    uint32_t key;
+} ll2_index_entry_t;
+
+/**
+ * @brief Value index for one list
+ *
+ * Slots use linear probing and are kept at most 70% full. Removal shifts the
+ * following entries back, so there are no tombstones. When stale is set the
+ * cached positions are out of date.
+ */
+typedef struct ll2_index_s {
+    ll2_index_entry_t *slots;
+    size_t mask;
+    size_t used;
+    int stale;
+} ll2_index_t;
+
+/**
+ * @brief Creates an empty index
+ *
+ * @param index Location to put the new index
+ *
+ * @return A status code of type ll2_err_t
+ */
+ll2_err_t ll2_index_create(ll2_index_t **index);
+
+/**
+ * @brief Frees an index
+ *
+ * @param index The index to free
+ *
+ * @return A status code of type ll2_err_t
+ */
+ll2_err_t ll2_index_destroy(ll2_index_t *index);
+
+/**
+ * @brief Removes every entry and keeps the table
+ *
+ * @param index The index to clear
+ */
+void ll2_index_clear(ll2_index_t *index);
+
+/**
+ * @brief Makes sure a number of entries fit without growing later
+ *
+ * This function grows the table if needed so that it has a slot for each of
+ * count values. Returns LL2_MEM if the table can not be grown.
+ *
+ * @param index The index to grow
+ * @param count The number of entries that must fit
+ *
+ * @return A status code of type ll2_err_t
+ */
+ll2_err_t ll2_index_reserve(ll2_index_t *index, size_t count);
+
+/**
+ * @brief Adds a node to the index
+ *
+ * The table must have room, see ll2_index_reserve. A node whose value is
+ * already in the index goes on that entry's array, and the function returns
+ * LL2_MEM if the array can not grow. The index is unchanged in that case.
+ *
+ * @param index The index to add to
+ * @param node The node to add, keyed by its data
+ * @param pos The position of the node in its list
+ *
+ * @return A status code of type ll2_err_t
+ */
+ll2_err_t ll2_index_insert(ll2_index_t *index, ll2_node_t *node, size_t pos);
+
+/**
+ * @brief Removes a node from the index
+ *
+ * This is O(1) for a value held once and otherwise a scan of that value's
+ * array, which never touches the entries of other values.
+ *
+ * @param index The index to remove from
+ * @param node The node to remove, its data must not have changed
+ */
+void ll2_index_erase(ll2_index_t *index, ll2_node_t *node);
+
+/**
+ * @brief Finds a node holding a value
+ *
+ * @param index The index to look in
+ * @param data The value to look for
+ *
+ * @return A node holding data, or NULL if there is none
+ */
+ll2_node_t *ll2_index_find(ll2_index_t *index, uint32_t data);
+
+/**
+ * @brief Finds the position of the first node holding a value
+ *
+ * This function renumbers the positions from head first if they are stale.
+ * Returns LL2_DATA if no node holds data.
+ *
+ * @param index The index to look in
+ * @param head The first node of the indexed list
+ * @param data The value to look for
+ * @param pos A pointer to return the position
+ *
+ * @return A status code of type ll2_err_t
+ */
+ll2_err_t ll2_index_position(ll2_index_t *index, ll2_node_t *head, uint32_t data, size_t *pos);
+
+#endif /* __LL2_INDEX_H__ */
@@ -0,0 +1,175 @@
+/*******************************************************************************
+* Copyright (C) 2017 by Ben Heberlein
+*
+* Redistribution, modification or use of this software in source or binary
+* forms is permitted as long as the files maintain this copyright. This file
+* was created for the University of Colorado Boulder course Advanced Practical
+* Embedded Software Development. Ben Heberlein and the University of Colorado
+* are not liable for any misuse of this material.
+*
+*******************************************************************************/
+/**
+ * @file ll2a.h
+ * @brief The interface for a compact array backed doubly linked list
+ *
+ * This header file provides the interface for a doubly linked list whose
+ * nodes live in one growable array and link to each other by 32 bit slot
+ * numbers instead of pointers. A node is 12 bytes against 24 for ll2_node_t,
+ * so twice as many fit in a cache line. Slot numbers stay valid when the
+ * array moves, so the whole list can be copied or written out with memcpy.
+ * Freed slots are kept on a free list and reused before the array grows.
+ *
+ * @author Ben Heberlein
+ * @date October 17 2026
+ * @version 1.0
+ *
+ */
+
+#ifndef __LL2A_H__
+#define __LL2A_H__
+
+#include <stddef.h>
+#include <stdint.h>
+#include "ll2.h"
+
+/**
+ * @brief Slot number that marks the end of a chain
+ */
+#define LL2A_NIL UINT32_MAX
+
+/**
+ * @brief Structure for a node, linked by slot number
+ */
+typedef struct ll2a_node_s {
+    uint32_t data;
+    uint32_t prev;
+    uint32_t next;
+} ll2a_node_t;
+
+/**
+ * @brief Structure for an array backed list
+ *
+ * Slots below used have been handed out at least once. Slots on the free
+ * list are chained through next.
+ */
+typedef struct ll2a_list_s {
+    ll2a_node_t *nodes;
+    uint32_t capacity;
+    uint32_t used;
+    uint32_t free;
+    uint32_t head;
+    uint32_t tail;
+    uint32_t count;
+} ll2a_list_t;
+
+/**
+ * @brief Sets up an empty list
+ *
+ * This function reserves room for capacity nodes, which may be 0. If the
+ * array can not be allocated, the function returns LL2_MEM.
+ *
+ * @param list The list to set up
+ * @param capacity The number of nodes to reserve
+ *
+ * @return A status code of type ll2_err_t
+ */
+ll2_err_t ll2a_init(ll2a_list_t *list, size_t capacity);
+
+/**
+ * @brief Destroys the list
+ *
+ * This function frees the node array and leaves the list empty and ready
+ * for reuse.
+ *
+ * @param list The list to destroy
+ *
+ * @return A status code of type ll2_err_t
+ */
+ll2_err_t ll2a_destroy(ll2a_list_t *list);
+
+/**
+ * @brief Adds data to the list at the specified index
+ *
+ * This function walks from the closer end and adds data so that it ends up
+ * at index. If the index is past the end, the function returns LL2_INDEX. If
+ * the array can not grow, it returns LL2_MEM.
+ *
+ * @param list The list to add to
+ * @param data The data that should be inserted
+ * @param index The index to insert at
+ *
+ * @return A status code of type ll2_err_t
+ */
+ll2_err_t ll2a_add(ll2a_list_t *list, uint32_t data, size_t index);
+
+/**
+ * @brief Appends data to the end of the list in O(1)
+ *
+ * @param list The list to add to
+ * @param data The data that should be appended
+ *
+ * @return A status code of type ll2_err_t
+ */
+ll2_err_t ll2a_push_back(ll2a_list_t *list, uint32_t data);
+
+/**
+ * @brief Removes the node at the specified index
+ *
+ * The slot goes on the free list. If the index is out of bounds, the
+ * function returns LL2_INDEX.
+ *
+ * @param list The list to remove from
+ * @param index The index that should be deleted
+ *
+ * @return A status code of type ll2_err_t
+ */
+ll2_err_t ll2a_remove(ll2a_list_t *list, size_t index);
+
+/**
+ * @brief Reads the value at the specified index
+ *
+ * @param list The list to read from
+ * @param index The index to read
+ * @param data A pointer to return the value
+ *
+ * @return A status code of type ll2_err_t
+ */
+ll2_err_t ll2a_get(ll2a_list_t *list, size_t index, uint32_t *data);
+
+/**
+ * @brief Searches the list for data
+ *
+ * This function returns the index of the first node with the data through
+ * the index pointer. If the data is not found, the function returns LL2_DATA.
+ *
+ * @param list The list to search
+ * @param data The data to search for in the list
+ * @param index A pointer to return the index of the data
+ *
+ * @return A status code of type ll2_err_t
+ */
+ll2_err_t ll2a_search(ll2a_list_t *list, uint32_t data, size_t *index);
+
+/**
+ * @brief Returns the number of values in the list in O(1)
+ *
+ * @param list The list to get the size of
+ *
+ * @return The number of values in the list
+ */
+size_t ll2a_size(ll2a_list_t *list);
+
+/**
+ * @brief Copies a list with one memcpy of its node array
+ *
+ * dst gets its own array holding the used slots of src and must not hold a
+ * list. If the array can not be allocated, the function returns LL2_MEM.
+ *
+ * @param dst The list to copy into
+ * @param src The list to copy
+ *
+ * @return A status code of type ll2_err_t
+ */
+ll2_err_t ll2a_copy(ll2a_list_t *dst, const ll2a_list_t *src);
+
+#endif /* __LL2A_H__ */
@@ -0,0 +1,205 @@
+/*******************************************************************************
+* Copyright (C) 2017 by Ben Heberlein
+*
+* Redistribution, modification or use of this software in source or binary
+* forms is permitted as long as the files maintain this copyright. This file
+* was created for the University of Colorado Boulder course Advanced Practical
+* Embedded Software Development. Ben Heberlein and the University of Colorado
+* are not liable for any misuse of this material.
+*
+*******************************************************************************/
+/**
+ * @file ll2c.h
+ * @brief The interface for a lock-free concurrent list
+ *
+ * This header file provides the interface for a list that many threads can
+ * search and change at once without a lock. It is a Harris style list: a node
+ * is removed by first marking the low bit of its next pointer, which stops
+ * anyone linking after it, and then swinging its predecessor past it. Search
+ * and get only read, so readers never write a shared cache line.
+ *
+ * Nodes taken out of the list are freed with epoch based reclamation. Every
+ * thread registers once and gets a slot. An operation announces the global
+ * epoch in that slot while it runs, and a node retired in epoch e is freed
+ * once the global epoch reaches e + 2, when no running operation can still
+ * hold it.
+ *
+ * Lock-free updates can not keep a second set of links consistent, so unlike
+ * ll2 the list is only linked forward. Indices mean the position at the
+ * moment the operation walked past it.
+ *
+ * @author Ben Heberlein
+ * @date October 17 2026
+ * @version 1.0
+ *
+ */
+
+#ifndef __LL2C_H__
+#define __LL2C_H__
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdatomic.h>
+#include "ll2.h"
+
+/**
+ * @brief Most threads that can be registered with one list at a time
+ */
+#define LL2C_MAX_THREADS 32
+
+/**
+ * @brief Size used to keep each thread slot on its own cache line
+ */
+#define LL2C_CACHE_LINE 64
+
+/**
+ * @brief Structure for a node. The low bit of next marks it as removed.
+ */
+typedef struct ll2c_node_s {
+    _Atomic uintptr_t next;
+    struct ll2c_node_s *retired;
+    uint32_t data;
+} ll2c_node_t;
+
+/**
+ * @brief Per thread reclamation state
+ *
+ * local holds the announced epoch shifted up by one with the low bit set
+ * while an operation runs, or 0 when the thread is outside the list. Retired
+ * nodes wait in one of three lists, tagged with the epoch they were retired
+ * in.
+ */
+typedef struct ll2c_thread_s {
+    _Alignas(LL2C_CACHE_LINE) _Atomic uint64_t local;
+    _Atomic int used;
+    uint32_t retired_count;
+    ll2c_node_t *retired[3];
+    uint64_t retired_epoch[3];
+} ll2c_thread_t;
+
+/**
+ * @brief Structure for a concurrent list
+ */
+typedef struct ll2c_list_s {
+    ll2c_node_t *head;
+    _Alignas(LL2C_CACHE_LINE) _Atomic uint64_t epoch;
+    _Alignas(LL2C_CACHE_LINE) _Atomic size_t count;
+    ll2c_thread_t threads[LL2C_MAX_THREADS];
+} ll2c_list_t;
+
+/**
+ * @brief Sets up an empty list
+ *
+ * This function allocates the sentinel head node. Returns LL2_MEM if it can
+ * not.
+ *
+ * @param list The list to set up
+ *
+ * @return A status code of type ll2_err_t
+ */
+ll2_err_t ll2c_init(ll2c_list_t *list);
+
+/**
+ * @brief Destroys the list
+ *
+ * This function frees every node, including the ones still waiting to be
+ * reclaimed. No other thread may be using the list.
+ *
+ * @param list The list to destroy
+ *
+ * @return A status code of type ll2_err_t
+ */
+ll2_err_t ll2c_destroy(ll2c_list_t *list);
+
+/**
+ * @brief Registers the calling thread with the list
+ *
+ * Each thread must register before its first operation and pass the slot it
+ * gets to every call. A slot must not be shared between threads.
+ *
+ * @param list The list to register with
+ *
+ * @return The thread slot, or NULL if all LL2C_MAX_THREADS are taken
+ */
+ll2c_thread_t *ll2c_thread_register(ll2c_list_t *list);
+
+/**
+ * @brief Gives a thread slot back
+ *
+ * Nodes the thread retired stay with the slot and are freed by the next
+ * thread to use it, or by ll2c_destroy.
+ *
+ * @param thread The slot to give back
+ */
+void ll2c_thread_unregister(ll2c_thread_t *thread);
+
+/**
+ * @brief Adds data to the list at the specified index
+ *
+ * This function links a new node so that it ends up at index. If the index
+ * is past the end, the function returns LL2_INDEX. If a node can not be
+ * allocated, it returns LL2_MEM.
+ *
+ * @param list The list to add to
+ * @param thread The slot of the calling thread
+ * @param data The data that should be inserted
+ * @param index The index to insert at
+ *
+ * @return A status code of type ll2_err_t
+ */
+ll2_err_t ll2c_add(ll2c_list_t *list, ll2c_thread_t *thread, uint32_t data, size_t index);
+
+/**
+ * @brief Removes the node at the specified index
+ *
+ * If the index is out of bounds, the function returns LL2_INDEX.
+ *
+ * @param list The list to remove from
+ * @param thread The slot of the calling thread
+ * @param index The index that should be deleted
+ *
+ * @return A status code of type ll2_err_t
+ */
+ll2_err_t ll2c_remove(ll2c_list_t *list, ll2c_thread_t *thread, size_t index);
+
+/**
+ * @brief Reads the value at the specified index
+ *
+ * @param list The list to read from
+ * @param thread The slot of the calling thread
+ * @param index The index to read
+ * @param data A pointer to return the value
+ *
+ * @return A status code of type ll2_err_t
+ */
+ll2_err_t ll2c_get(ll2c_list_t *list, ll2c_thread_t *thread, size_t index, uint32_t *data);
+
+/**
+ * @brief Searches the list for data
+ *
+ * This function returns the index of the first node with the data through
+ * the index pointer. If the data is not found, the function returns
+ * LL2_DATA. It only reads the list, so searches scale with the number of
+ * threads.
+ *
+ * @param list The list to search
+ * @param thread The slot of the calling thread
+ * @param data The data to search for in the list
+ * @param index A pointer to return the index of the data
+ *
+ * @return A status code of type ll2_err_t
+ */
+ll2_err_t ll2c_search(ll2c_list_t *list, ll2c_thread_t *thread, uint32_t data, size_t *index);
+
+/**
+ * @brief Returns the number of values in the list
+ *
+ * The count is exact when no update is running.
+ *
+ * @param list The list to get the size of
+ *
+ * @return The number of values in the list
+ */
+size_t ll2c_size(ll2c_list_t *list);
+
+#endif /* __LL2C_H__ */
@@ -0,0 +1,234 @@
+/*******************************************************************************
+* Copyright (C) 2017 by Ben Heberlein
+*
+* Redistribution, modification or use of this software in source or binary
+* forms is permitted as long as the files maintain this copyright. This file
+* was created for the University of Colorado Boulder course Advanced Practical
+* Embedded Software Development. Ben Heberlein and the University of Colorado
+* are not liable for any misuse of this material.
+*
+*******************************************************************************/
+/**
+ * @file ll2i.h
+ * @brief The interface for an intrusive doubly linked list
+ *
+ * This header file provides the interface for a doubly linked list that never
+ * allocates. Callers embed an ll2i_link_t in their own structures and hand the
+ * list a pointer to it, then get back to the structure with LL2I_CONTAINER.
+ * Adding, unlinking and moving a link between lists are O(1). The list is a
+ * ring closed by a link inside ll2i_list_t, so none of them have to check for
+ * an empty list or for the ends.
+ *
+ * @author Ben Heberlein
+ * @date October 17 2026
+ * @version 1.0
+ *
+ */
+
+#ifndef __LL2I_H__
+#define __LL2I_H__
+
+#include <stddef.h>
+#include <stdint.h>
+#include "ll2.h"
+
+/**
+ * @brief Returns the structure of the given type that holds link as member
+ */
+#define LL2I_CONTAINER(link, type, member) \
+    ((type *) ((char *) (link) - offsetof(type, member)))
+
+/**
+ * @brief Walks every link of a list from the front. The loop body must not
+ * unlink link, use ll2i_next before unlinking instead.
+ */
+#define LL2I_FOREACH(link, list) \
+    for ((link) = ll2i_first(list); (link) != NULL; (link) = ll2i_next((list), (link)))
+
+/**
+ * @brief Link to embed in a structure that goes on a list
+ *
+ * Both pointers are NULL while the link is on no list.
+ */
+typedef struct ll2i_link_s {
+    struct ll2i_link_s *prev;
+    struct ll2i_link_s *next;
+} ll2i_link_t;
+
+/**
+ * @brief Structure for an intrusive list
+ *
+ * ring.next is the first link and ring.prev the last. Both point back at ring
+ * when the list is empty.
+ */
+typedef struct ll2i_list_s {
+    ll2i_link_t ring;
+    size_t count;
+} ll2i_list_t;
+
+/**
+ * @brief Sets up an empty list
+ *
+ * @param list The list to set up
+ *
+ * @return A status code of type ll2_err_t
+ */
+ll2_err_t ll2i_init(ll2i_list_t *list);
+
+/**
+ * @brief Marks a link as being on no list
+ *
+ * A link must be set up once before it is first added. Unlinking sets it up
+ * again, so it can go straight on another list.
+ *
+ * @param link The link to set up
+ *
+ * @return A status code of type ll2_err_t
+ */
+ll2_err_t ll2i_link_init(ll2i_link_t *link);
+
+/**
+ * @brief Returns whether a link is on a list
+ *
+ * @param link The link to check
+ *
+ * @return 1 if the link is on a list, 0 if not or if link is NULL
+ */
+int ll2i_is_linked(const ll2i_link_t *link);
+
+/**
+ * @brief Adds a link at the front of the list in O(1)
+ *
+ * If the link is already on a list, the function returns LL2_DATA.
+ *
+ * @param list The list to add to
+ * @param link The link to add
+ *
+ * @return A status code of type ll2_err_t
+ */
+ll2_err_t ll2i_push_front(ll2i_list_t *list, ll2i_link_t *link);
+
+/**
+ * @brief Adds a link at the back of the list in O(1)
+ *
+ * If the link is already on a list, the function returns LL2_DATA.
+ *
+ * @param list The list to add to
+ * @param link The link to add
+ *
+ * @return A status code of type ll2_err_t
+ */
+ll2_err_t ll2i_push_back(ll2i_list_t *list, ll2i_link_t *link);
+
+/**
+ * @brief Adds a link right before another one in O(1)
+ *
+ * pos must be on list. If link is already on a list or pos is not, the
+ * function returns LL2_DATA.
+ *
+ * @param list The list pos is on
+ * @param pos The link to add before
+ * @param link The link to add
+ *
+ * @return A status code of type ll2_err_t
+ */
+ll2_err_t ll2i_insert_before(ll2i_list_t *list, ll2i_link_t *pos, ll2i_link_t *link);
+
+/**
+ * @brief Adds a link right after another one in O(1)
+ *
+ * pos must be on list. If link is already on a list or pos is not, the
+ * function returns LL2_DATA.
+ *
+ * @param list The list pos is on
+ * @param pos The link to add after
+ * @param link The link to add
+ *
+ * @return A status code of type ll2_err_t
+ */
+ll2_err_t ll2i_insert_after(ll2i_list_t *list, ll2i_link_t *pos, ll2i_link_t *link);
+
+/**
+ * @brief Takes a link off the list in O(1)
+ *
+ * link must be on list. The structure holding it is left alone, freeing it is
+ * up to the caller. If the link is on no list, the function returns LL2_DATA.
+ *
+ * @param list The list link is on
+ * @param link The link to take off
+ *
+ * @return A status code of type ll2_err_t
+ */
+ll2_err_t ll2i_unlink(ll2i_list_t *list, ll2i_link_t *link);
+
+/**
+ * @brief Moves a link from one list to the back of another in O(1)
+ *
+ * link must be on src. src and dst may be the same list, which moves the link
+ * to the back. If the link is on no list, the function returns LL2_DATA.
+ *
+ * @param dst The list to move to
+ * @param src The list link is on
+ * @param link The link to move
+ *
+ * @return A status code of type ll2_err_t
+ */
+ll2_err_t ll2i_move(ll2i_list_t *dst, ll2i_list_t *src, ll2i_link_t *link);
+
+/**
+ * @brief Takes the first link off the list in O(1)
+ *
+ * @param list The list to take from
+ *
+ * @return The first link, or NULL if the list is empty
+ */
+ll2i_link_t *ll2i_pop_front(ll2i_list_t *list);
+
+/**
+ * @brief Returns the first link of the list
+ *
+ * @param list The list to look at
+ *
+ * @return The first link, or NULL if the list is empty
+ */
+ll2i_link_t *ll2i_first(ll2i_list_t *list);
+
+/**
+ * @brief Returns the last link of the list
+ *
+ * @param list The list to look at
+ *
+ * @return The last link, or NULL if the list is empty
+ */
+ll2i_link_t *ll2i_last(ll2i_list_t *list);
+
+/**
+ * @brief Returns the link after a link on the list
+ *
+ * @param list The list link is on
+ * @param link The link to step from
+ *
+ * @return The next link, or NULL at the back of the list
+ */
+ll2i_link_t *ll2i_next(ll2i_list_t *list, ll2i_link_t *link);
+
+/**
+ * @brief Returns the link before a link on the list
+ *
+ * @param list The list link is on
+ * @param link The link to step from
+ *
+ * @return The previous link, or NULL at the front of the list
+ */
+ll2i_link_t *ll2i_prev(ll2i_list_t *list, ll2i_link_t *link);
+
+/**
+ * @brief Returns the number of links on the list in O(1)
+ *
+ * @param list The list to get the size of
+ *
+ * @return The number of links on the list
+ */
+size_t ll2i_size(ll2i_list_t *list);
+
+#endif /* __LL2I_H__ */
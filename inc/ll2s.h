@@ -0,0 +1,152 @@
+/*******************************************************************************
+* Copyright (C) 2017 by Ben Heberlein
+*
+* Redistribution, modification or use of this software in source or binary
+* forms is permitted as long as the files maintain this copyright. This file
+* was created for the University of Colorado Boulder course Advanced Practical
+* Embedded Software Development. Ben Heberlein and the University of Colorado
+* are not liable for any misuse of this material.
+*
+*******************************************************************************/
+/**
+ * @file ll2s.h
+ * @brief The interface for an indexable skip list
+ *
+ * This header file provides the interface for a positional sequence built as
+ * an indexable skip list. Every link records how many values it jumps over,
+ * so adding, removing and reading at an index take O(log n) expected time
+ * instead of a walk from the head. The functions have the same index based
+ * shape as ll2 and ll2u, with size_t indices.
+ *
+ * @author Ben Heberlein
+ * @date October 17 2026
+ * @version 1.0
+ *
+ */
+
+#ifndef __LL2S_H__
+#define __LL2S_H__
+
+#include <stddef.h>
+#include <stdint.h>
+#include "ll2.h"
+
+/**
+ * @brief Highest level a node can have. A node reaches each next level with
+ * probability 1/4, so this covers far more values than fit in memory.
+ */
+#define LL2S_MAX_LEVEL 16
+
+/**
+ * @brief One forward link and the number of positions it moves
+ */
+typedef struct ll2s_link_s {
+    struct ll2s_node_s *next;
+    size_t width;
+} ll2s_link_t;
+
+/**
+ * @brief Structure for a node with level links
+ */
+typedef struct ll2s_node_s {
+    uint32_t data;
+    uint32_t level;
+    ll2s_link_t link[];
+} ll2s_node_t;
+
+/**
+ * @brief Structure for an indexable skip list
+ */
+typedef struct ll2s_list_s {
+    ll2s_node_t *head;
+    size_t count;
+    uint32_t level;
+    uint64_t seed;
+} ll2s_list_t;
+
+/**
+ * @brief Sets up an empty skip list
+ *
+ * This function allocates the head node. Returns LL2_MEM if it can not.
+ *
+ * @param list The list to set up
+ *
+ * @return A status code of type ll2_err_t
+ */
+ll2_err_t ll2s_init(ll2s_list_t *list);
+
+/**
+ * @brief Destroys the list
+ *
+ * This function frees every node, including the head, and leaves the list
+ * empty and ready for reuse. The head is allocated again by the next add.
+ *
+ * @param list The list to destroy
+ *
+ * @return A status code of type ll2_err_t
+ */
+ll2_err_t ll2s_destroy(ll2s_list_t *list);
+
+/**
+ * @brief Adds data to the list at the specified index in O(log n)
+ *
+ * This function adds data so that it ends up at index. If the index is past
+ * the end, the function returns LL2_INDEX. If a node can not be allocated,
+ * it returns LL2_MEM.
+ *
+ * @param list The list to add to
+ * @param data The data that should be inserted
+ * @param index The index to insert at
+ *
+ * @return A status code of type ll2_err_t
+ */
+ll2_err_t ll2s_add(ll2s_list_t *list, uint32_t data, size_t index);
+
+/**
+ * @brief Removes the value at the specified index in O(log n)
+ *
+ * If the index is out of bounds, the function returns LL2_INDEX.
+ *
+ * @param list The list to remove from
+ * @param index The index that should be deleted
+ *
+ * @return A status code of type ll2_err_t
+ */
+ll2_err_t ll2s_remove(ll2s_list_t *list, size_t index);
+
+/**
+ * @brief Reads the value at the specified index in O(log n)
+ *
+ * @param list The list to read from
+ * @param index The index to read
+ * @param data A pointer to return the value
+ *
+ * @return A status code of type ll2_err_t
+ */
+ll2_err_t ll2s_get(ll2s_list_t *list, size_t index, uint32_t *data);
+
+/**
+ * @brief Searches the list for data
+ *
+ * This function walks the bottom level and returns the index of the first
+ * value equal to data through the index pointer. If the data is not found,
+ * the function returns LL2_DATA.
+ *
+ * @param list The list to search
+ * @param data The data to search for in the list
+ * @param index A pointer to return the index of the data
+ *
+ * @return A status code of type ll2_err_t
+ */
+ll2_err_t ll2s_search(ll2s_list_t *list, uint32_t data, size_t *index);
+
+/**
+ * @brief Returns the number of values in the list in O(1)
+ *
+ * @param list The list to get the size of
+ *
+ * @return The number of values in the list
+ */
+size_t ll2s_size(ll2s_list_t *list);
+
+#endif /* __LL2S_H__ */
@@ -0,0 +1,160 @@
+/*******************************************************************************
+* Copyright (C) 2017 by Ben Heberlein
+*
+* Redistribution, modification or use of this software in source or binary
+* forms is permitted as long as the files maintain this copyright. This file
+* was created for the University of Colorado Boulder course Advanced Practical
+* Embedded Software Development. Ben Heberlein and the University of Colorado
+* are not liable for any misuse of this material.
+*
+*******************************************************************************/
+/**
+ * @file ll2u.h
+ * @brief The interface for an unrolled doubly linked list
+ *
+ * This header file provides the interface for an unrolled doubly linked list.
+ * Each node holds a block of values with a fill count instead of a single
+ * value, so walking and searching the list reads contiguous memory. The list
+ * has the same index based add, remove and search functions as ll2, and
+ * splits and merges blocks as needed without the caller seeing it.
+ *
+ * @author Ben Heberlein
+ * @date October 17 2026
+ * @version 1.0
+ *
+ */
+
+#ifndef __LL2U_H__
+#define __LL2U_H__
+
+#include <stddef.h>
+#include <stdint.h>
+#include "ll2.h"
+
+/**
+ * @brief Number of values in a block, chosen so a block fills two cache lines
+ */
+#define LL2U_BLOCK_ITEMS 27
+
+/**
+ * @brief Structure for a block of values
+ */
+typedef struct ll2u_block_s {
+    struct ll2u_block_s *prev;
+    struct ll2u_block_s *next;
+    uint32_t count;
+    uint32_t data[LL2U_BLOCK_ITEMS];
+} ll2u_block_t;
+
+/**
+ * @brief Structure for an unrolled list
+ */
+typedef struct ll2u_list_s {
+    ll2u_block_t *head;
+    ll2u_block_t *tail;
+    size_t count;
+} ll2u_list_t;
+
+/**
+ * @brief Sets up an empty unrolled list
+ *
+ * @param list The list to set up
+ *
+ * @return A status code of type ll2_err_t
+ */
+ll2_err_t ll2u_init(ll2u_list_t *list);
+
+/**
+ * @brief Destroys all blocks in the list
+ *
+ * This function frees every block and leaves the list empty and ready for
+ * reuse. Returns LL2_SUCCESS for successful operation.
+ *
+ * @param list The list to destroy
+ *
+ * @return A status code of type ll2_err_t
+ */
+ll2_err_t ll2u_destroy(ll2u_list_t *list);
+
+/**
+ * @brief Adds data to the list at the specified index
+ *
+ * This function adds data so that it ends up at index. A full block is split
+ * in two first. If the index is past the end, the function returns
+ * LL2_INDEX. If a block can not be allocated, it returns LL2_MEM.
+ *
+ * @param list The list to add to
+ * @param data The data that should be inserted
+ * @param index The index to insert at
+ *
+ * @return A status code of type ll2_err_t
+ */
+ll2_err_t ll2u_add(ll2u_list_t *list, uint32_t data, size_t index);
+
+/**
+ * @brief Removes the value at the specified index
+ *
+ * This function removes the value at index. A block that gets small enough
+ * is merged with the next one. If the index is out of bounds, the function
+ * returns LL2_INDEX.
+ *
+ * @param list The list to remove from
+ * @param index The index that should be deleted
+ *
+ * @return A status code of type ll2_err_t
+ */
+ll2_err_t ll2u_remove(ll2u_list_t *list, size_t index);
+
+/**
+ * @brief Reads the value at the specified index
+ *
+ * @param list The list to read from
+ * @param index The index to read
+ * @param data A pointer to return the value
+ *
+ * @return A status code of type ll2_err_t
+ */
+ll2_err_t ll2u_get(ll2u_list_t *list, size_t index, uint32_t *data);
+
+/**
+ * @brief Searches the list for data
+ *
+ * This function returns the index of the first value equal to data through
+ * the index pointer and returns LL2_SUCCESS. Each block is scanned with the
+ * SIMD kernels from simd_find.h. If the data is not found, the
+ * function returns LL2_DATA.
+ *
+ * @param list The list to search
+ * @param data The data to search for in the list
+ * @param index A pointer to return the index of the data
+ *
+ * @return A status code of type ll2_err_t
+ */
+ll2_err_t ll2u_search(ll2u_list_t *list, uint32_t data, size_t *index);
+
+/**
+ * @brief Searches the list for a value inside a range
+ *
+ * This function returns the index of the first value with lo <= value <= hi
+ * through the index pointer and returns LL2_SUCCESS. If there is none, the
+ * function returns LL2_DATA.
+ *
+ * @param list The list to search
+ * @param lo The smallest value that matches
+ * @param hi The largest value that matches
+ * @param index A pointer to return the index of the value
+ *
+ * @return A status code of type ll2_err_t
+ */
+ll2_err_t ll2u_search_range(ll2u_list_t *list, uint32_t lo, uint32_t hi, size_t *index);
+
+/**
+ * @brief Returns the number of values in the list in O(1)
+ *
+ * @param list The list to get the size of
+ *
+ * @return The number of values in the list
+ */
+size_t ll2u_size(ll2u_list_t *list);
+
+#endif /* __LL2U_H__ */
@@ -0,0 +1,55 @@
+/**********************************************************
+* Name: simd_find.h
+*
+* Date: 10/17/2026
+*
+* Author: Ben Heberlein
+*
+* Description: This file defines search kernels over
+* contiguous runs of uint32_t values, used by circbuf and
+* ll2u. On x86 the AVX2 or SSE2 version is picked at run
+* time from CPUID, everything else gets a plain loop.
+*
+**********************************************************/
+
+#ifndef SIMD_FIND_H
+#define SIMD_FIND_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/***********************************************************
+* simd_find_eq      : size_t simd_find_eq(const uint32_t *data, size_t count, uint32_t value);
+*   returns         : Index of the first item equal to value, or count if none
+*   data            : Start of the run
+*   count           : Number of items in the run
+*   value           : Value to look for
+* Author            : Ben Heberlein
+* Date              : 10/17/2026
+* Description       : Find the first item equal to a value
+***********************************************************/
+size_t simd_find_eq(const uint32_t *data, size_t count, uint32_t value);
+
+/***********************************************************
+* simd_find_range   : size_t simd_find_range(const uint32_t *data, size_t count, uint32_t lo, uint32_t hi);
+*   returns         : Index of the first item in [lo, hi], or count if none
+*   data            : Start of the run
+*   count           : Number of items in the run
+*   lo              : Smallest value that matches
+*   hi              : Largest value that matches, an empty range if below lo
+* Author            : Ben Heberlein
+* Date              : 10/17/2026
+* Description       : Find the first item inside an inclusive range
+***********************************************************/
+size_t simd_find_range(const uint32_t *data, size_t count, uint32_t lo, uint32_t hi);
+
+/***********************************************************
+* simd_find_impl    : const char *simd_find_impl(void);
+*   returns         : "avx2", "sse2" or "scalar"
+* Author            : Ben Heberlein
+* Date              : 10/17/2026
+* Description       : Name the kernels picked for this CPU
+***********************************************************/
+const char *simd_find_impl(void);
+
+#endif
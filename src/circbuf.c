@@ -11,12 +11,247 @@
 *
 **********************************************************/
 
+#ifndef CIRCBUF_EMBEDDED
+#define _GNU_SOURCE
+#endif
+
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include "circbuf.h"
+#include "simd_find.h"
 
+#ifdef CIRCBUF_EMBEDDED
 #define MAX_CAP 1024
+#else
+#include <stddef.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#define MAX_CAP 0x80000000UL
+#define HUGE_PAGE (2UL * 1024 * 1024)
+#endif
+
+#ifdef CIRCBUF_HAVE_WAIT
+#include <time.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+#include <linux/membarrier.h>
+#endif
+
+// Adaptive spin budget of the blocking calls
+#define SPIN_MIN 16
+#define SPIN_MAX 4096
+
+/***********************************************************
+* circbuf_buf_alloc  : static uint32_t *circbuf_buf_alloc(size_t count, size_t *map_len);
+*   returns          : Pointer to the item memory, or NULL if out of memory
+*   count            : Number of items to make room for
+*   map_len          : Set to the mapped length, or 0 for heap memory
+* Description        : Get the item memory for a buffer. Small buffers come
+*                      from the heap aligned to a cache line. Buffers of a
+*                      huge page or more are mapped with huge pages, falling
+*                      back to a normal mapping marked for transparent huge
+*                      pages when none are reserved. Embedded builds always
+*                      use plain malloc.
+***********************************************************/
+static uint32_t *circbuf_buf_alloc(size_t count, size_t *map_len) {
+    size_t bytes = count * sizeof(uint32_t);
+
+    *map_len = 0;
+
+#ifdef CIRCBUF_EMBEDDED
+    return (uint32_t *) malloc(bytes);
+#else
+    if (bytes >= HUGE_PAGE) {
+        size_t len = (bytes + HUGE_PAGE - 1) & ~(HUGE_PAGE - 1);
+        void *mem = mmap(NULL, len, PROT_READ | PROT_WRITE,
+                         MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (mem == MAP_FAILED) {
+            mem = mmap(NULL, len, PROT_READ | PROT_WRITE,
+                       MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (mem == MAP_FAILED) {
+                return NULL;
+            }
+#ifdef MADV_HUGEPAGE
+            madvise(mem, len, MADV_HUGEPAGE);
+#endif
+        }
+        *map_len = len;
+        return (uint32_t *) mem;
+    }
+
+    // aligned_alloc wants the size to be a multiple of the alignment
+    bytes = (bytes + CIRCBUF_CACHE_LINE - 1) & ~((size_t) CIRCBUF_CACHE_LINE - 1);
+    return (uint32_t *) aligned_alloc(CIRCBUF_CACHE_LINE, bytes);
+#endif
+}
+
+/***********************************************************
+* circbuf_buf_free   : static void circbuf_buf_free(uint32_t *buf, size_t map_len);
+*   buf              : Item memory from circbuf_buf_alloc
+*   map_len          : The mapped length it returned
+* Description        : Give back the item memory of a buffer
+***********************************************************/
+static void circbuf_buf_free(uint32_t *buf, size_t map_len) {
+#ifndef CIRCBUF_EMBEDDED
+    if (map_len != 0) {
+        munmap(buf, map_len);
+        return;
+    }
+#else
+    (void) map_len;
+#endif
+    free(buf);
+}
+
+/***********************************************************
+* Internal helpers that hide the difference between the
+* pointer mode and the CIRCBUF_POW2 index mode.
+***********************************************************/
+static inline circbuf_count_t circbuf_used(circbuf_t *circular_buffer) {
+    if (circular_buffer->flags & CIRCBUF_POW2) {
+        return (circbuf_count_t) (circular_buffer->pos->in - circular_buffer->pos->out);
+    }
+    return circular_buffer->size;
+}
+
+static inline uint32_t *circbuf_head_ptr(circbuf_t *circular_buffer) {
+    if (circular_buffer->flags & CIRCBUF_POW2) {
+        return circular_buffer->buf + (circular_buffer->pos->in & circular_buffer->mask);
+    }
+    return circular_buffer->head;
+}
+
+static inline uint32_t *circbuf_tail_ptr(circbuf_t *circular_buffer) {
+    if (circular_buffer->flags & CIRCBUF_POW2) {
+        return circular_buffer->buf + (circular_buffer->pos->out & circular_buffer->mask);
+    }
+    return circular_buffer->tail;
+}
+
+/***********************************************************
+* Overwrite mode helpers. The oldest item is dropped by
+* moving tail on, and writes are bracketed by seq_begin
+* and seq the way a seqlock is, so circbuf_snapshot can
+* tell which of the items it copied were overwritten.
+***********************************************************/
+static inline void circbuf_drop_oldest(circbuf_t *circular_buffer) {
+    circular_buffer->pos->dropped++;
+
+    if (circular_buffer->flags & CIRCBUF_POW2) {
+        circular_buffer->pos->out++;
+        return;
+    }
+
+    circular_buffer->tail++;
+    if ((circbuf_count_t) (circular_buffer->tail - circular_buffer->buf) >= circular_buffer->capacity) {
+        circular_buffer->tail -= circular_buffer->capacity;
+    }
+    circular_buffer->size--;
+}
+
+static inline void circbuf_write_begin(circbuf_t *circular_buffer, circbuf_count_t count) {
+    if (circular_buffer->flags & CIRCBUF_OVERWRITE) {
+        uint64_t end = atomic_load_explicit(&circular_buffer->pos->seq, memory_order_relaxed) + count;
+        if (end > atomic_load_explicit(&circular_buffer->pos->seq_begin, memory_order_relaxed)) {
+            atomic_store_explicit(&circular_buffer->pos->seq_begin, end, memory_order_relaxed);
+            atomic_thread_fence(memory_order_release);
+        }
+    }
+}
+
+static inline void circbuf_write_end(circbuf_t *circular_buffer, circbuf_count_t count) {
+    if (circular_buffer->flags & CIRCBUF_OVERWRITE) {
+        uint64_t end = atomic_load_explicit(&circular_buffer->pos->seq, memory_order_relaxed) + count;
+        atomic_store_explicit(&circular_buffer->pos->seq, end, memory_order_release);
+    }
+}
+
+/***********************************************************
+* Counter helpers for CIRCBUF_STATS builds. Each counter
+* has one writer, so a relaxed load and store is enough and
+* no locked instruction is needed. Without CIRCBUF_STATS
+* the macros expand to nothing.
+***********************************************************/
+#ifdef CIRCBUF_STATS
+static inline void circbuf_stat_bump(_Atomic uint64_t *counter, uint64_t count) {
+    uint64_t value = atomic_load_explicit(counter, memory_order_relaxed);
+    atomic_store_explicit(counter, value + count, memory_order_relaxed);
+}
+
+static inline void circbuf_stat_high(circbuf_prod_stats_t *stats, uint64_t used) {
+    if (used > atomic_load_explicit(&stats->high_water, memory_order_relaxed)) {
+        atomic_store_explicit(&stats->high_water, used, memory_order_relaxed);
+    }
+}
+
+static inline void circbuf_stat_level(circbuf_prod_stats_t *stats, uint64_t used) {
+    unsigned bucket = (used == 0) ? 0 : 64 - (unsigned) __builtin_clzll(used);
+
+    circbuf_stat_bump(&stats->histogram[bucket], 1);
+    circbuf_stat_high(stats, used);
+}
+
+static void circbuf_stat_init(circbuf_prod_stats_t *prod, circbuf_cons_stats_t *cons) {
+    atomic_init(&prod->adds, 0);
+    atomic_init(&prod->full, 0);
+    atomic_init(&prod->high_water, 0);
+    for (unsigned i = 0; i < CIRCBUF_STATS_BUCKETS; i++) {
+        atomic_init(&prod->histogram[i], 0);
+    }
+    atomic_init(&cons->removes, 0);
+    atomic_init(&cons->empty, 0);
+}
+
+#define CIRCBUF_STAT_INIT(owner) circbuf_stat_init(&(owner)->prod_stats, &(owner)->cons_stats)
+#define CIRCBUF_STAT_BUMP(counter, count) circbuf_stat_bump(&(counter), (count))
+#define CIRCBUF_STAT_ADDED(cb, count) \
+    do { \
+        circbuf_stat_bump(&(cb)->prod_stats.adds, (count)); \
+        circbuf_stat_level(&(cb)->prod_stats, circbuf_used(cb)); \
+    } while (0)
+#else
+#define CIRCBUF_STAT_INIT(owner)
+#define CIRCBUF_STAT_BUMP(counter, count)
+#define CIRCBUF_STAT_ADDED(cb, count)
+#endif
+
+/***********************************************************
+* circbuf_move_tail  : static void circbuf_move_tail(circbuf_count_t count, circbuf_t *circular_buffer);
+*   count            : Number of items to drop, at most the current size
+*   circular_buffer  : The circular buffer to drop from
+* Description        : Drop the oldest count items. Shared by circbuf_release
+*                      and the overwrite path of circbuf_add_n, which must
+*                      not count the items it drops as removed.
+***********************************************************/
+static void circbuf_move_tail(circbuf_count_t count, circbuf_t *circular_buffer) {
+    if (circular_buffer->flags & CIRCBUF_POW2) {
+        circular_buffer->pos->out += count;
+        return;
+    }
+
+    if (count == 0) {
+        return;
+    }
+
+    // Move tail and check for wrap
+    circular_buffer->tail += count;
+    if ((circbuf_count_t) (circular_buffer->tail - circular_buffer->buf) >= circular_buffer->capacity) {
+        circular_buffer->tail -= circular_buffer->capacity;
+    }
+    circular_buffer->size -= count;
+
+    // Set new state
+    if (circular_buffer->size == 0) {
+        circular_buffer->STATUS = EMPTY;
+    } else {
+        circular_buffer->STATUS = PARTIAL;
+    }
+}
 
 /***********************************************************
 * circbuf_is_full     : circbuf_err_t circbuf_buffer_full(circbuf_t *circular_buffer);
@@ -32,6 +267,13 @@ circbuf_err_t circbuf_is_full(circbuf_t *circular_buffer) {
         return ERR_NULLPTR;
     }
 
+    if (circular_buffer->flags & CIRCBUF_POW2) {
+        if (circular_buffer->pos->in - circular_buffer->pos->out == circular_buffer->capacity) {
+            return ERR_FULL;
+        }
+        return ERR_PARTIAL;
+    }
+
     if (circular_buffer->STATUS == FULL) {
         return ERR_FULL;
     } else {
@@ -53,6 +295,13 @@ circbuf_err_t circbuf_is_empty(circbuf_t *circular_buffer) {
         return ERR_NULLPTR;
     }
 
+    if (circular_buffer->flags & CIRCBUF_POW2) {
+        if (circular_buffer->pos->in == circular_buffer->pos->out) {
+            return ERR_EMPTY;
+        }
+        return ERR_PARTIAL;
+    }
+
     if (circular_buffer->STATUS == EMPTY) {
         return ERR_EMPTY;
     } else {
@@ -75,20 +324,47 @@ circbuf_err_t circbuf_add(uint32_t data, circbuf_t *circular_buffer) {
         return ERR_NULLPTR;
     }
 
-    // Check if full
+    if (circular_buffer->flags & CIRCBUF_READONLY) {
+        return ERR_CONFIG;
+    }
+
+    // Index mode only needs a subtract and a mask
+    if (circular_buffer->flags & CIRCBUF_POW2) {
+        if (circular_buffer->pos->in - circular_buffer->pos->out == circular_buffer->capacity) {
+            if (!(circular_buffer->flags & CIRCBUF_OVERWRITE)) {
+                CIRCBUF_STAT_BUMP(circular_buffer->prod_stats.full, 1);
+                return ERR_FULL;
+            }
+            circbuf_drop_oldest(circular_buffer);
+        }
+        circbuf_write_begin(circular_buffer, 1);
+        circular_buffer->buf[circular_buffer->pos->in & circular_buffer->mask] = data;
+        circular_buffer->pos->in++;
+        circbuf_write_end(circular_buffer, 1);
+        CIRCBUF_STAT_ADDED(circular_buffer, 1);
+        return ERR_SUCCESS;
+    }
+
+    // Check if full, making room in overwrite mode
     if (circular_buffer->STATUS == FULL) {
-        return ERR_FULL;
+        if (!(circular_buffer->flags & CIRCBUF_OVERWRITE)) {
+            CIRCBUF_STAT_BUMP(circular_buffer->prod_stats.full, 1);
+            return ERR_FULL;
+        }
+        circbuf_drop_oldest(circular_buffer);
     }
 
     // Set data
+    circbuf_write_begin(circular_buffer, 1);
     *(circular_buffer->head) = data;
 
     // Increment head and check for wrap
     circular_buffer->head++;
-    if ((circular_buffer->head - circular_buffer->buf) >= circular_buffer->capacity) {
+    if ((circbuf_count_t) (circular_buffer->head - circular_buffer->buf) >= circular_buffer->capacity) {
         circular_buffer->head -= circular_buffer->capacity;
     }
     circular_buffer->size++;
+    circbuf_write_end(circular_buffer, 1);
 
     // Set new state
     if (circular_buffer->size == circular_buffer->capacity ||
@@ -97,6 +373,7 @@ circbuf_err_t circbuf_add(uint32_t data, circbuf_t *circular_buffer) {
     } else {
         circular_buffer->STATUS = PARTIAL;
     }
+    CIRCBUF_STAT_ADDED(circular_buffer, 1);
 
     return ERR_SUCCESS;
 }
@@ -116,8 +393,25 @@ circbuf_err_t circbuf_remove(uint32_t *data, circbuf_t *circular_buffer) {
         return ERR_NULLPTR;
     }
 
+    if (circular_buffer->flags & CIRCBUF_READONLY) {
+        return ERR_CONFIG;
+    }
+
+    // Index mode only needs a compare and a mask
+    if (circular_buffer->flags & CIRCBUF_POW2) {
+        if (circular_buffer->pos->in == circular_buffer->pos->out) {
+            CIRCBUF_STAT_BUMP(circular_buffer->cons_stats.empty, 1);
+            return ERR_EMPTY;
+        }
+        *data = circular_buffer->buf[circular_buffer->pos->out & circular_buffer->mask];
+        circular_buffer->pos->out++;
+        CIRCBUF_STAT_BUMP(circular_buffer->cons_stats.removes, 1);
+        return ERR_SUCCESS;
+    }
+
     // Check if empty
     if (circular_buffer->STATUS == EMPTY) {
+        CIRCBUF_STAT_BUMP(circular_buffer->cons_stats.empty, 1);
         return ERR_EMPTY;
     }
 
@@ -126,7 +420,7 @@ circbuf_err_t circbuf_remove(uint32_t *data, circbuf_t *circular_buffer) {
 
     // Increment tail and check for wrap
     circular_buffer->tail++;
-    if ((circular_buffer->tail - circular_buffer->buf) >= circular_buffer->capacity) {
+    if ((circbuf_count_t) (circular_buffer->tail - circular_buffer->buf) >= circular_buffer->capacity) {
         circular_buffer->tail -= circular_buffer->capacity;
     }
     circular_buffer->size--;
@@ -137,20 +431,292 @@ circbuf_err_t circbuf_remove(uint32_t *data, circbuf_t *circular_buffer) {
     } else {
         circular_buffer->STATUS = PARTIAL;
     }
+    CIRCBUF_STAT_BUMP(circular_buffer->cons_stats.removes, 1);
+
+    return ERR_SUCCESS;
+}
+
+
+/***********************************************************
+* circbuf_add_n     : circbuf_count_t circbuf_add_n(const uint32_t *data, circbuf_count_t count, circbuf_t *circular_buffer);
+*   returns         : Number of items actually added, 0 if full or on error.
+*                     In CIRCBUF_OVERWRITE mode all count items are taken
+*                     and the oldest ones are dropped to make room.
+*   data            : Array of data to be added
+*   count           : Number of items in data
+*   circular_buffer : The circular buffer to be added to
+* Author            : Ben Heberlein
+* Date              : 10/17/2026
+* Description       : Add as many items as fit, copying at most two runs
+*                     around the wrap and updating the state once
+***********************************************************/
+circbuf_count_t circbuf_add_n(const uint32_t *data, circbuf_count_t count, circbuf_t *circular_buffer) {
+    circbuf_region_t region;
+    circbuf_count_t skipped = 0;
+
+    // Check if valid data
+    if (data == NULL || circular_buffer == NULL) {
+        return 0;
+    }
+
+    if (circular_buffer->flags & CIRCBUF_READONLY) {
+        return 0;
+    }
+
+    // Make room by dropping the oldest items, or the oldest new ones
+    if (circular_buffer->flags & CIRCBUF_OVERWRITE) {
+        if (count > circular_buffer->capacity) {
+            skipped = count - circular_buffer->capacity;
+            circular_buffer->pos->dropped += skipped;
+            data += skipped;
+            count = circular_buffer->capacity;
+        }
+        circbuf_count_t space = circular_buffer->capacity - circbuf_used(circular_buffer);
+        if (count > space) {
+            circbuf_move_tail(count - space, circular_buffer);
+            circular_buffer->pos->dropped += count - space;
+        }
+    }
+
+    circbuf_count_t n = circbuf_reserve(count, &region, circular_buffer);
+    CIRCBUF_STAT_BUMP(circular_buffer->prod_stats.full, count - n);
+    if (n == 0) {
+        return skipped;
+    }
+
+    // Copy up to the end of the buffer, then the rest from the start
+    memcpy(region.span[0], data, region.len[0] * sizeof(uint32_t));
+    memcpy(region.span[1], data + region.len[0], region.len[1] * sizeof(uint32_t));
+
+    circbuf_commit(n, circular_buffer);
+    return n + skipped;
+}
+
+/***********************************************************
+* circbuf_remove_n  : circbuf_count_t circbuf_remove_n(uint32_t *data, circbuf_count_t count, circbuf_t *circular_buffer);
+*   returns         : Number of items actually removed, 0 if empty or on error
+*   data            : Array to put data in, must hold count items
+*   count           : Maximum number of items to remove
+*   circular_buffer : The circular buffer to get data from
+* Author            : Ben Heberlein
+* Date              : 10/17/2026
+* Description       : Remove up to count items, copying at most two runs
+*                     around the wrap and updating the state once
+***********************************************************/
+circbuf_count_t circbuf_remove_n(uint32_t *data, circbuf_count_t count, circbuf_t *circular_buffer) {
+    circbuf_region_t region;
+
+    // Check if valid data
+    if (data == NULL || circular_buffer == NULL) {
+        return 0;
+    }
+
+    if (circular_buffer->flags & CIRCBUF_READONLY) {
+        return 0;
+    }
+
+    circbuf_count_t n = circbuf_peek(count, &region, circular_buffer);
+    if (n == 0) {
+        CIRCBUF_STAT_BUMP(circular_buffer->cons_stats.empty, count > 0);
+        return 0;
+    }
+
+    // Copy up to the end of the buffer, then the rest from the start
+    memcpy(data, region.span[0], region.len[0] * sizeof(uint32_t));
+    memcpy(data + region.len[0], region.span[1], region.len[1] * sizeof(uint32_t));
+
+    circbuf_release(n, circular_buffer);
+    return n;
+}
+
+/***********************************************************
+* circbuf_reserve   : circbuf_count_t circbuf_reserve(circbuf_count_t count, circbuf_region_t *region, circbuf_t *circular_buffer);
+*   returns         : Number of items reserved, 0 if full or on error
+*   count           : Maximum number of items wanted
+*   region          : Filled with the writable runs
+*   circular_buffer : The circular buffer to write into
+* Author            : Ben Heberlein
+* Date              : 10/17/2026
+* Description       : Hand out free space after head for writing in place.
+*                     Nothing is added until circbuf_commit is called.
+*                     Never overwrites, even in CIRCBUF_OVERWRITE mode.
+***********************************************************/
+circbuf_count_t circbuf_reserve(circbuf_count_t count, circbuf_region_t *region, circbuf_t *circular_buffer) {
+    // Check if valid buffer
+    if (circular_buffer == NULL || region == NULL) {
+        return 0;
+    }
+
+    if (circular_buffer->flags & CIRCBUF_READONLY) {
+        return 0;
+    }
+
+    // Only hand out what is free
+    circbuf_count_t n = circular_buffer->capacity - circbuf_used(circular_buffer);
+    if (count < n) {
+        n = count;
+    }
+
+    // Split the space at the end of the buffer
+    uint32_t *head = circbuf_head_ptr(circular_buffer);
+    circbuf_count_t first = (circbuf_count_t) (circular_buffer->buf + circular_buffer->capacity - head);
+    if (first > n) {
+        first = n;
+    }
+    region->span[0] = head;
+    region->len[0] = first;
+    region->span[1] = circular_buffer->buf;
+    region->len[1] = n - first;
+
+    circbuf_write_begin(circular_buffer, n);
+    return n;
+}
+
+/***********************************************************
+* circbuf_commit    : circbuf_err_t circbuf_commit(circbuf_count_t count, circbuf_t *circular_buffer);
+*   returns         : ERR_SUCCESS for success, ERR_CONFIG if count is more than
+*                     the free space, or other error
+*   count           : Number of reserved items that were written
+*   circular_buffer : The circular buffer that was written into
+* Author            : Ben Heberlein
+* Date              : 10/17/2026
+* Description       : Add the first count items of the last reservation
+***********************************************************/
+circbuf_err_t circbuf_commit(circbuf_count_t count, circbuf_t *circular_buffer) {
+    // Check if valid buffer
+    if (circular_buffer == NULL) {
+        return ERR_NULLPTR;
+    }
+
+    if (circular_buffer->flags & CIRCBUF_READONLY) {
+        return ERR_CONFIG;
+    }
+
+    // Can not commit more than could have been reserved
+    if (count > circular_buffer->capacity - circbuf_used(circular_buffer)) {
+        return ERR_CONFIG;
+    }
+
+    if (circular_buffer->flags & CIRCBUF_POW2) {
+        circular_buffer->pos->in += count;
+        circbuf_write_end(circular_buffer, count);
+        CIRCBUF_STAT_ADDED(circular_buffer, count);
+        return ERR_SUCCESS;
+    }
+
+    if (count == 0) {
+        return ERR_SUCCESS;
+    }
+
+    // Move head and check for wrap
+    circular_buffer->head += count;
+    if ((circbuf_count_t) (circular_buffer->head - circular_buffer->buf) >= circular_buffer->capacity) {
+        circular_buffer->head -= circular_buffer->capacity;
+    }
+    circular_buffer->size += count;
+    circbuf_write_end(circular_buffer, count);
+
+    // Set new state
+    if (circular_buffer->size == circular_buffer->capacity) {
+        circular_buffer->STATUS = FULL;
+    } else {
+        circular_buffer->STATUS = PARTIAL;
+    }
+    CIRCBUF_STAT_ADDED(circular_buffer, count);
 
     return ERR_SUCCESS;
 }
 
+/***********************************************************
+* circbuf_peek      : circbuf_count_t circbuf_peek(circbuf_count_t count, circbuf_region_t *region, circbuf_t *circular_buffer);
+*   returns         : Number of items visible, 0 if empty or on error
+*   count           : Maximum number of items wanted
+*   region          : Filled with the readable runs, oldest first
+*   circular_buffer : The circular buffer to read from
+* Author            : Ben Heberlein
+* Date              : 10/17/2026
+* Description       : Hand out stored items starting at tail for reading in
+*                     place. Nothing is removed until circbuf_release is called.
+***********************************************************/
+circbuf_count_t circbuf_peek(circbuf_count_t count, circbuf_region_t *region, circbuf_t *circular_buffer) {
+    // Check if valid buffer
+    if (circular_buffer == NULL || region == NULL) {
+        return 0;
+    }
+
+    // Only hand out what is stored
+    circbuf_count_t n = circbuf_used(circular_buffer);
+    if (count < n) {
+        n = count;
+    }
+
+    // Split the data at the end of the buffer
+    uint32_t *tail = circbuf_tail_ptr(circular_buffer);
+    circbuf_count_t first = (circbuf_count_t) (circular_buffer->buf + circular_buffer->capacity - tail);
+    if (first > n) {
+        first = n;
+    }
+    region->span[0] = tail;
+    region->len[0] = first;
+    region->span[1] = circular_buffer->buf;
+    region->len[1] = n - first;
+
+    return n;
+}
 
 /***********************************************************
-* circbuf_allocate   : circbuf_err_t circbuf_allocate(uint16_t capacity, circbuf_t **circular_buffer);
+* circbuf_release   : circbuf_err_t circbuf_release(circbuf_count_t count, circbuf_t *circular_buffer);
+*   returns         : ERR_SUCCESS for success, ERR_CONFIG if count is more than
+*                     the current size, or other error
+*   count           : Number of peeked items that are done with
+*   circular_buffer : The circular buffer that was read from
+* Author            : Ben Heberlein
+* Date              : 10/17/2026
+* Description       : Remove the oldest count items without copying them
+***********************************************************/
+circbuf_err_t circbuf_release(circbuf_count_t count, circbuf_t *circular_buffer) {
+    // Check if valid buffer
+    if (circular_buffer == NULL) {
+        return ERR_NULLPTR;
+    }
+
+    if (circular_buffer->flags & CIRCBUF_READONLY) {
+        return ERR_CONFIG;
+    }
+
+    // Can not release more than is stored
+    if (count > circbuf_used(circular_buffer)) {
+        return ERR_CONFIG;
+    }
+
+    circbuf_move_tail(count, circular_buffer);
+    CIRCBUF_STAT_BUMP(circular_buffer->cons_stats.removes, count);
+
+    return ERR_SUCCESS;
+}
+
+/***********************************************************
+* circbuf_allocate   : circbuf_err_t circbuf_allocate(circbuf_count_t capacity, circbuf_t **circular_buffer);
 *   returns          : ERR_SUCCESS if successful, or another error if failed with *circular_buffer set to NULL
-*   capacity         : Capacity of the buffer
+*   capacity         : Capacity of the buffer, at most 1024 for embedded builds
 * Author             : Ben Heberlein
 * Date               : 9/7/2017
 * Description        : Initialize a new circular buffer and put it at the location of circular_buffer
 ***********************************************************/
-circbuf_err_t circbuf_allocate(uint16_t capacity, circbuf_t **init)  {
+circbuf_err_t circbuf_allocate(circbuf_count_t capacity, circbuf_t **init)  {
+	return circbuf_allocate_ex(capacity, 0, init);
+}
+
+/***********************************************************
+* circbuf_allocate_ex : circbuf_err_t circbuf_allocate_ex(circbuf_count_t capacity, uint32_t flags, circbuf_t **circular_buffer);
+*   returns           : ERR_SUCCESS if successful, or another error if failed with *circular_buffer set to NULL
+*   capacity          : Capacity of the buffer, must be a power of two for CIRCBUF_POW2
+*   flags             : Bitwise or of circbuf_flag_t values
+* Author              : Ben Heberlein
+* Date                : 10/17/2026
+* Description         : Initialize a new circular buffer in the given mode
+***********************************************************/
+circbuf_err_t circbuf_allocate_ex(circbuf_count_t capacity, uint32_t flags, circbuf_t **init)  {
 
   //check zero case
   if(capacity == 0) return ERR_CONFIG;
@@ -158,15 +724,23 @@ circbuf_err_t circbuf_allocate(uint16_t capacity, circbuf_t **init)  {
   // check maximum
   if (capacity > MAX_CAP) return ERR_CONFIG;
 
-	*init = (circbuf_t *) malloc(sizeof(circbuf_t));
+  // index mode wraps with a mask
+  if ((flags & CIRCBUF_POW2) && (capacity & (capacity - 1)) != 0) return ERR_CONFIG;
+
+  // mapped buffers come from circbuf_map and circbuf_attach
+  if (flags & (CIRCBUF_MAPPED | CIRCBUF_READONLY)) return ERR_CONFIG;
+
+	// The stats counters need their cache line alignment
+	*init = (circbuf_t *) aligned_alloc(_Alignof(circbuf_t), sizeof(circbuf_t));
 	if (*init == NULL) {
 		return ERR_MEM;
 	}
 
 	(*init)->buf = NULL;
-	(*init)->buf = (uint32_t *) malloc(capacity * sizeof(uint32_t));
+	(*init)->buf = circbuf_buf_alloc(capacity, &(*init)->map_len);
 	if ((*init)->buf == NULL) {
 		free(*init);
+		*init = NULL;
 		return ERR_MEM;
 	}
 
@@ -175,10 +749,191 @@ circbuf_err_t circbuf_allocate(uint16_t capacity, circbuf_t **init)  {
 	(*init)->capacity = capacity;
 	(*init)->size = 0;
 	(*init)->STATUS = EMPTY;
+	(*init)->flags = flags;
+	(*init)->mask = capacity - 1;
+	(*init)->pos = &(*init)->pos_local;
+	(*init)->pos->in = 0;
+	(*init)->pos->out = 0;
+	(*init)->pos->dropped = 0;
+	atomic_init(&(*init)->pos->seq, 0);
+	atomic_init(&(*init)->pos->seq_begin, 0);
+	CIRCBUF_STAT_INIT(*init);
 
 	return ERR_SUCCESS;
 }
 
+#ifndef CIRCBUF_EMBEDDED
+/***********************************************************
+* circbuf_map_view   : static circbuf_err_t circbuf_map_view(circbuf_file_hdr_t *hdr, size_t len, uint32_t flags, circbuf_t **circular_buffer);
+*   returns          : ERR_SUCCESS if successful, or ERR_MEM with the mapping released
+*   hdr              : Start of a checked file mapping
+*   len              : Length of the mapping
+*   flags            : Mode flags for the view
+*   circular_buffer  : Location to put the new buffer
+* Description        : Wrap a file mapping in a circbuf_t that works on it in place
+***********************************************************/
+static circbuf_err_t circbuf_map_view(circbuf_file_hdr_t *hdr, size_t len, uint32_t flags,
+                                      circbuf_t **init) {
+	*init = (circbuf_t *) aligned_alloc(_Alignof(circbuf_t), sizeof(circbuf_t));
+	if (*init == NULL) {
+		munmap(hdr, len);
+		return ERR_MEM;
+	}
+
+	(*init)->buf = (uint32_t *) ((uint8_t *) hdr + hdr->data_offset);
+	(*init)->head = (*init)->buf;
+	(*init)->tail = (*init)->buf;
+	(*init)->capacity = (circbuf_count_t) hdr->capacity;
+	(*init)->size = 0;
+	(*init)->STATUS = EMPTY;
+	(*init)->flags = flags | CIRCBUF_POW2 | CIRCBUF_MAPPED;
+	(*init)->mask = (uint32_t) (hdr->capacity - 1);
+	(*init)->pos = &hdr->pos;
+	(*init)->map_len = len;
+	CIRCBUF_STAT_INIT(*init);
+
+	return ERR_SUCCESS;
+}
+
+/***********************************************************
+* circbuf_map        : circbuf_err_t circbuf_map(const char *path, circbuf_count_t capacity, uint32_t flags, circbuf_t **circular_buffer);
+*   returns          : ERR_SUCCESS if successful, ERR_CONFIG if the file holds a
+*                      different or newer buffer, or another error
+*   path             : File to keep the buffer in, e.g. under /dev/shm
+*   capacity         : Capacity of the buffer, must be a power of two
+*   flags            : Bitwise or of circbuf_flag_t values, CIRCBUF_POW2 is implied
+*   circular_buffer  : Location to put the new buffer
+* Author             : Ben Heberlein
+* Date               : 10/17/2026
+* Description        : Initialize a circular buffer whose header and items live
+*                      in a shared file mapping, so its contents survive a crash
+*                      of the process. If the file already holds a buffer with
+*                      the same capacity it is picked up where it left off.
+***********************************************************/
+circbuf_err_t circbuf_map(const char *path, circbuf_count_t capacity, uint32_t flags, circbuf_t **init) {
+    if (path == NULL || init == NULL) {
+        return ERR_NULLPTR;
+    }
+
+    // Positions in the file are always masked indices
+    if (capacity == 0 || capacity > MAX_CAP || (capacity & (capacity - 1)) != 0) {
+        return ERR_CONFIG;
+    }
+    if (flags & (CIRCBUF_MAPPED | CIRCBUF_READONLY)) {
+        return ERR_CONFIG;
+    }
+    flags |= CIRCBUF_POW2;
+
+    int fd = open(path, O_RDWR | O_CREAT, 0644);
+    if (fd < 0) {
+        return ERR_UNKNOWN;
+    }
+
+    struct stat st;
+    size_t len = CIRCBUF_FILE_DATA_OFFSET + capacity * sizeof(uint32_t);
+    if (fstat(fd, &st) != 0) {
+        close(fd);
+        return ERR_UNKNOWN;
+    }
+
+    // A new file is sized here, an old one has to be big enough already
+    int fresh = (st.st_size == 0);
+    if (fresh && ftruncate(fd, (off_t) len) != 0) {
+        close(fd);
+        return ERR_MEM;
+    }
+    if (!fresh && (size_t) st.st_size < len) {
+        close(fd);
+        return ERR_CONFIG;
+    }
+
+    circbuf_file_hdr_t *hdr = (circbuf_file_hdr_t *) mmap(NULL, len, PROT_READ | PROT_WRITE,
+                                                          MAP_SHARED, fd, 0);
+    close(fd);
+    if (hdr == MAP_FAILED) {
+        return ERR_MEM;
+    }
+
+    if (fresh) {
+        // The file is zero filled, magic goes in last so a half made header is never valid
+        hdr->version = CIRCBUF_FILE_VERSION;
+        hdr->data_offset = CIRCBUF_FILE_DATA_OFFSET;
+        hdr->elem_size = sizeof(uint32_t);
+        hdr->capacity = capacity;
+        hdr->flags = flags;
+        atomic_thread_fence(memory_order_release);
+        hdr->magic = CIRCBUF_FILE_MAGIC;
+    } else if (hdr->magic != CIRCBUF_FILE_MAGIC ||
+               hdr->version != CIRCBUF_FILE_VERSION ||
+               hdr->data_offset != CIRCBUF_FILE_DATA_OFFSET ||
+               hdr->elem_size != sizeof(uint32_t) ||
+               hdr->capacity != capacity ||
+               hdr->flags != flags ||
+               (uint32_t) (hdr->pos.in - hdr->pos.out) > hdr->capacity) {
+        munmap(hdr, len);
+        return ERR_CONFIG;
+    }
+
+    return circbuf_map_view(hdr, len, flags, init);
+}
+
+/***********************************************************
+* circbuf_attach     : circbuf_err_t circbuf_attach(const char *path, circbuf_t **circular_buffer);
+*   returns          : ERR_SUCCESS if successful, ERR_CONFIG if the file is not a
+*                      buffer this version understands, or another error
+*   path             : File written by circbuf_map
+*   circular_buffer  : Location to put the read only view
+* Author             : Ben Heberlein
+* Date               : 10/17/2026
+* Description        : Map an existing file backed buffer read only, for example
+*                      from another process or a post-mortem tool. Only
+*                      functions that do not change the buffer may be used, the
+*                      others return ERR_CONFIG. Release it with circbuf_destroy.
+***********************************************************/
+circbuf_err_t circbuf_attach(const char *path, circbuf_t **init) {
+    if (path == NULL || init == NULL) {
+        return ERR_NULLPTR;
+    }
+
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        return ERR_UNKNOWN;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        close(fd);
+        return ERR_UNKNOWN;
+    }
+    if ((size_t) st.st_size < sizeof(circbuf_file_hdr_t)) {
+        close(fd);
+        return ERR_CONFIG;
+    }
+
+    size_t len = (size_t) st.st_size;
+    circbuf_file_hdr_t *hdr = (circbuf_file_hdr_t *) mmap(NULL, len, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (hdr == MAP_FAILED) {
+        return ERR_MEM;
+    }
+
+    // Check everything the view relies on before trusting it
+    if (hdr->magic != CIRCBUF_FILE_MAGIC ||
+        hdr->version != CIRCBUF_FILE_VERSION ||
+        hdr->elem_size != sizeof(uint32_t) ||
+        hdr->data_offset < sizeof(circbuf_file_hdr_t) ||
+        hdr->capacity == 0 || hdr->capacity > MAX_CAP ||
+        (hdr->capacity & (hdr->capacity - 1)) != 0 ||
+        hdr->data_offset + hdr->capacity * sizeof(uint32_t) > len ||
+        (uint32_t) (hdr->pos.in - hdr->pos.out) > hdr->capacity) {
+        munmap(hdr, len);
+        return ERR_CONFIG;
+    }
+
+    return circbuf_map_view(hdr, len, (hdr->flags & CIRCBUF_OVERWRITE) | CIRCBUF_READONLY, init);
+}
+#endif
+
 /***********************************************************
 * circbuf_destroy    : circbuf_err_t circbuf_destroy(circbuf_t *circular_buf);
 *   returns          : ERR_SUCCESS for successful destroy or other error
@@ -197,7 +952,17 @@ circbuf_err_t circbuf_destroy(circbuf_t *circular_buf) {
 		return ERR_NULLPTR;
 	}
 
-	free(circular_buf->buf);
+#ifndef CIRCBUF_EMBEDDED
+	// The mapping of a file backed buffer starts at its header
+	if (circular_buf->flags & CIRCBUF_MAPPED) {
+		munmap((uint8_t *) circular_buf->pos - offsetof(circbuf_file_hdr_t, pos),
+		       circular_buf->map_len);
+		free(circular_buf);
+		return ERR_SUCCESS;
+	}
+#endif
+
+	circbuf_buf_free(circular_buf->buf, circular_buf->map_len);
 	free(circular_buf);
 	return ERR_SUCCESS;
 }
@@ -219,12 +984,13 @@ circbuf_err_t circbuf_dump(circbuf_t *circular_buf) {
         return ERR_NULLPTR;
     }
 
-    uint32_t *temp = circular_buf->tail;
-    uint16_t ctr = 0;
+    uint32_t *temp = circbuf_tail_ptr(circular_buf);
+    circbuf_count_t size = circbuf_used(circular_buf);
+    circbuf_count_t ctr = 0;
 
     printf("Circular buffer from tail to head:\n");
 
-    while (ctr < circular_buf->size) {
+    while (ctr < size) {
         printf("%d\n", *temp);        
         temp++;
         ctr++;
@@ -237,18 +1003,687 @@ circbuf_err_t circbuf_dump(circbuf_t *circular_buf) {
 }
 
 /*********************************************************** 
-* circbuf_size       : uint16_t circbuf_size(circbuf_t *circular_buf); 
+* circbuf_size       : circbuf_count_t circbuf_size(circbuf_t *circular_buf); 
 *   return           : current_number of items stored 
 *   circular)buf     : Circular buffer to get size of 
 * Author             : Ben Heberlein 
 * Date               : 09/07/2017 
 * Description        : Returns the size of the given circular buffer 
 ***********************************************************/ 
-uint16_t circbuf_size(circbuf_t *circular_buf) {
+circbuf_count_t circbuf_size(circbuf_t *circular_buf) {
     if (circular_buf == NULL) {
-        return (uint16_t) ERR_NULLPTR;
+        return (circbuf_count_t) ERR_NULLPTR;
+    }
+
+    return circbuf_used(circular_buf);
+}
+
+/***********************************************************
+* circbuf_dropped    : uint64_t circbuf_dropped(circbuf_t *circular_buf);
+*   return           : number of items dropped, 0 on error
+*   circular_buf     : Circular buffer in CIRCBUF_OVERWRITE mode
+* Author             : Ben Heberlein
+* Date               : 10/17/2026
+* Description        : Returns how many items have been overwritten or
+*                      skipped because the buffer was full
+***********************************************************/
+uint64_t circbuf_dropped(circbuf_t *circular_buf) {
+    if (circular_buf == NULL) {
+        return 0;
+    }
+
+    return circular_buf->pos->dropped;
+}
+
+/***********************************************************
+* circbuf_snapshot   : circbuf_count_t circbuf_snapshot(uint32_t *data, circbuf_count_t count, circbuf_t *circular_buf);
+*   return           : number of items copied, 0 on error
+*   data             : Array to copy into, oldest item first
+*   count            : Maximum number of items wanted
+*   circular_buf     : Circular buffer in CIRCBUF_OVERWRITE mode
+* Author             : Ben Heberlein
+* Date               : 10/17/2026
+* Description        : Copies the newest count items ever written without
+*                      removing them, whether or not they have been read.
+*                      Takes no lock and may run on another thread while
+*                      the producer keeps adding. Items the producer
+*                      overwrote during the copy are left out, so fewer
+*                      than count may come back.
+***********************************************************/
+circbuf_count_t circbuf_snapshot(uint32_t *data, circbuf_count_t count, circbuf_t *circular_buf) {
+    if (circular_buf == NULL || data == NULL) {
+        return 0;
+    }
+
+    // Slot positions only follow seq in overwrite mode
+    if (!(circular_buf->flags & CIRCBUF_OVERWRITE)) {
+        return 0;
+    }
+
+    uint64_t end = atomic_load_explicit(&circular_buf->pos->seq, memory_order_acquire);
+    uint64_t n = count;
+    if (n > circular_buf->capacity) {
+        n = circular_buf->capacity;
+    }
+    if (n > end) {
+        n = end;
+    }
+
+    // Item number s always lives in slot s % capacity
+    uint64_t first = end - n;
+    circbuf_count_t slot = (circbuf_count_t) (first % circular_buf->capacity);
+    for (uint64_t i = 0; i < n; i++) {
+        data[i] = circular_buf->buf[slot];
+        slot++;
+        if (slot == circular_buf->capacity) {
+            slot = 0;
+        }
+    }
+
+    // Anything the producer started writing since may have replaced our oldest items
+    atomic_thread_fence(memory_order_acquire);
+    uint64_t begin = atomic_load_explicit(&circular_buf->pos->seq_begin, memory_order_relaxed);
+    if (begin > circular_buf->capacity && begin - circular_buf->capacity > first) {
+        uint64_t stale = begin - circular_buf->capacity - first;
+        if (stale >= n) {
+            return 0;
+        }
+        memmove(data, data + stale, (n - stale) * sizeof(uint32_t));
+        n -= stale;
+    }
+
+    return (circbuf_count_t) n;
+}
+
+#ifdef CIRCBUF_STATS
+/***********************************************************
+* circbuf_stat_copy  : static void circbuf_stat_copy(circbuf_stats_t *stats, circbuf_prod_stats_t *prod, circbuf_cons_stats_t *cons);
+*   stats            : Filled with a copy of the counters
+*   prod             : Producer side counters
+*   cons             : Consumer side counters
+* Description        : Read each live counter once
+***********************************************************/
+static void circbuf_stat_copy(circbuf_stats_t *stats, circbuf_prod_stats_t *prod, circbuf_cons_stats_t *cons) {
+    stats->adds = atomic_load_explicit(&prod->adds, memory_order_relaxed);
+    stats->full = atomic_load_explicit(&prod->full, memory_order_relaxed);
+    stats->high_water = atomic_load_explicit(&prod->high_water, memory_order_relaxed);
+    for (unsigned i = 0; i < CIRCBUF_STATS_BUCKETS; i++) {
+        stats->histogram[i] = atomic_load_explicit(&prod->histogram[i], memory_order_relaxed);
+    }
+    stats->removes = atomic_load_explicit(&cons->removes, memory_order_relaxed);
+    stats->empty = atomic_load_explicit(&cons->empty, memory_order_relaxed);
+}
+#endif
+
+/***********************************************************
+* circbuf_stats      : circbuf_err_t circbuf_stats(circbuf_stats_t *stats, circbuf_t *circular_buf);
+*   return           : ERR_SUCCESS, ERR_CONFIG if built without CIRCBUF_STATS,
+*                      or other error
+*   stats            : Filled with a copy of the counters
+*   circular_buf     : Circular buffer to read the counters of
+* Author             : Ben Heberlein
+* Date               : 10/17/2026
+* Description        : Copies out the occupancy and contention counters
+***********************************************************/
+circbuf_err_t circbuf_stats(circbuf_stats_t *stats, circbuf_t *circular_buf) {
+    if (stats == NULL || circular_buf == NULL) {
+        return ERR_NULLPTR;
+    }
+
+#ifdef CIRCBUF_STATS
+    circbuf_stat_copy(stats, &circular_buf->prod_stats, &circular_buf->cons_stats);
+    return ERR_SUCCESS;
+#else
+    memset(stats, 0, sizeof(*stats));
+    return ERR_CONFIG;
+#endif
+}
+
+/***********************************************************
+* circbuf_find       : circbuf_err_t circbuf_find(uint32_t data, circbuf_count_t *index, circbuf_t *circular_buf);
+*   return           : ERR_SUCCESS if found, ERR_NOTFOUND if not, or other error
+*   data             : Value to look for
+*   index            : Set to the position of the first match, 0 being the oldest item
+*   circular_buf     : Circular buffer to search
+* Author             : Ben Heberlein
+* Date               : 10/17/2026
+* Description        : Find the oldest stored item equal to data without
+*                      removing anything. Both runs around the wrap are
+*                      scanned with the widest SIMD kernel the CPU has.
+***********************************************************/
+circbuf_err_t circbuf_find(uint32_t data, circbuf_count_t *index, circbuf_t *circular_buf) {
+    if (circular_buf == NULL || index == NULL) {
+        return ERR_NULLPTR;
+    }
+
+    circbuf_region_t region;
+    circbuf_peek(circbuf_used(circular_buf), &region, circular_buf);
+
+    // The first run holds the oldest items
+    size_t at = simd_find_eq(region.span[0], region.len[0], data);
+    if (at < region.len[0]) {
+        *index = (circbuf_count_t) at;
+        return ERR_SUCCESS;
+    }
+
+    at = simd_find_eq(region.span[1], region.len[1], data);
+    if (at < region.len[1]) {
+        *index = (circbuf_count_t) (region.len[0] + at);
+        return ERR_SUCCESS;
+    }
+
+    return ERR_NOTFOUND;
+}
+
+/***********************************************************
+* circbuf_find_range : circbuf_err_t circbuf_find_range(uint32_t lo, uint32_t hi, circbuf_count_t *index, circbuf_t *circular_buf);
+*   return           : ERR_SUCCESS if found, ERR_NOTFOUND if not, or other error
+*   lo               : Smallest value that matches
+*   hi               : Largest value that matches
+*   index            : Set to the position of the first match, 0 being the oldest item
+*   circular_buf     : Circular buffer to search
+* Author             : Ben Heberlein
+* Date               : 10/17/2026
+* Description        : Find the oldest stored item with lo <= item <= hi,
+*                      searched the same way as circbuf_find
+***********************************************************/
+circbuf_err_t circbuf_find_range(uint32_t lo, uint32_t hi, circbuf_count_t *index, circbuf_t *circular_buf) {
+    if (circular_buf == NULL || index == NULL) {
+        return ERR_NULLPTR;
+    }
+
+    circbuf_region_t region;
+    circbuf_peek(circbuf_used(circular_buf), &region, circular_buf);
+
+    size_t at = simd_find_range(region.span[0], region.len[0], lo, hi);
+    if (at < region.len[0]) {
+        *index = (circbuf_count_t) at;
+        return ERR_SUCCESS;
+    }
+
+    at = simd_find_range(region.span[1], region.len[1], lo, hi);
+    if (at < region.len[1]) {
+        *index = (circbuf_count_t) (region.len[0] + at);
+        return ERR_SUCCESS;
+    }
+
+    return ERR_NOTFOUND;
+}
+
+#ifdef CIRCBUF_HAVE_WAIT
+/***********************************************************
+* Sleeping and waking in the blocking calls is a Dekker
+* style handshake: the sleeper raises its flag and then
+* checks the index, the other side moves the index and
+* then checks the flag. That needs a full barrier on both
+* sides. To keep it off the add/remove fast path the
+* sleeper uses membarrier to force the barrier onto the
+* other thread, and the fast path only needs to stop the
+* compiler from reordering. Without membarrier both sides
+* fall back to a real fence.
+*
+* circbuf_membarrier_state is 0 before the first
+* allocation, 1 when membarrier is registered and 2 when
+* fences have to be used.
+***********************************************************/
+static _Atomic int circbuf_membarrier_state = 0;
+
+static void circbuf_membarrier_init(void) {
+    int expected = 0;
+
+    if (atomic_load_explicit(&circbuf_membarrier_state, memory_order_acquire) != 0) {
+        return;
+    }
+
+    int state = 2;
+#ifdef SYS_membarrier
+    if (syscall(SYS_membarrier, MEMBARRIER_CMD_REGISTER_PRIVATE_EXPEDITED, 0, 0) == 0) {
+        state = 1;
+    }
+#endif
+    atomic_compare_exchange_strong(&circbuf_membarrier_state, &expected, state);
+}
+
+static inline void circbuf_barrier_fast(void) {
+    if (atomic_load_explicit(&circbuf_membarrier_state, memory_order_relaxed) == 1) {
+        atomic_signal_fence(memory_order_seq_cst);
+    } else {
+        atomic_thread_fence(memory_order_seq_cst);
+    }
+}
+
+static inline void circbuf_barrier_slow(void) {
+#ifdef SYS_membarrier
+    if (atomic_load_explicit(&circbuf_membarrier_state, memory_order_relaxed) == 1) {
+        syscall(SYS_membarrier, MEMBARRIER_CMD_PRIVATE_EXPEDITED, 0, 0);
+        return;
+    }
+#endif
+    atomic_thread_fence(memory_order_seq_cst);
+}
+
+static inline void circbuf_futex_wake(_Atomic uint32_t *word) {
+    syscall(SYS_futex, (void *) word, FUTEX_WAKE_PRIVATE, 1, NULL, NULL, 0);
+}
+
+static inline void circbuf_cpu_relax(void) {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    __asm__ __volatile__("yield");
+#endif
+}
+
+static uint64_t circbuf_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000000000ULL + (uint64_t) ts.tv_nsec;
+}
+
+/***********************************************************
+* circbuf_spsc_sleep : static int circbuf_spsc_sleep(_Atomic uint32_t *word, uint32_t val, _Atomic uint32_t *waiting, uint64_t deadline);
+*   returns          : 1 if the deadline has passed, 0 otherwise
+*   word             : The other side's index to sleep on
+*   val              : The value it has while we can not go on
+*   waiting          : Our flag in the other side's cache line
+*   deadline         : Absolute CLOCK_MONOTONIC time in ns, or CIRCBUF_WAIT_FOREVER
+* Description        : Sleep until the other side moves its index. May
+*                      return early, so callers retry in a loop.
+***********************************************************/
+static int circbuf_spsc_sleep(_Atomic uint32_t *word, uint32_t val,
+                              _Atomic uint32_t *waiting, uint64_t deadline) {
+    struct timespec rel;
+    struct timespec *relp = NULL;
+
+    if (deadline != CIRCBUF_WAIT_FOREVER) {
+        uint64_t now = circbuf_now_ns();
+        if (now >= deadline) {
+            return 1;
+        }
+        rel.tv_sec = (time_t) ((deadline - now) / 1000000000ULL);
+        rel.tv_nsec = (long) ((deadline - now) % 1000000000ULL);
+        relp = &rel;
+    }
+
+    // Either the other side sees the flag or we see its new index
+    atomic_store_explicit(waiting, 1, memory_order_relaxed);
+    circbuf_barrier_slow();
+    if (atomic_load_explicit(word, memory_order_relaxed) == val) {
+        syscall(SYS_futex, (void *) word, FUTEX_WAIT_PRIVATE, val, relp, NULL, 0);
+    }
+    atomic_store_explicit(waiting, 0, memory_order_relaxed);
+
+    return 0;
+}
+
+/***********************************************************
+* circbuf_deadline   : static uint64_t circbuf_deadline(uint64_t timeout_ns);
+*   returns          : Absolute deadline in ns, or CIRCBUF_WAIT_FOREVER
+*   timeout_ns       : Relative timeout in ns, or CIRCBUF_WAIT_FOREVER
+* Description        : Turn a timeout into a deadline without overflowing
+***********************************************************/
+static uint64_t circbuf_deadline(uint64_t timeout_ns) {
+    if (timeout_ns == CIRCBUF_WAIT_FOREVER) {
+        return CIRCBUF_WAIT_FOREVER;
+    }
+
+    uint64_t now = circbuf_now_ns();
+    if (timeout_ns >= CIRCBUF_WAIT_FOREVER - now) {
+        return CIRCBUF_WAIT_FOREVER - 1;
+    }
+    return now + timeout_ns;
+}
+#endif
+
+/***********************************************************
+* circbuf_spsc_allocate : circbuf_err_t circbuf_spsc_allocate(circbuf_count_t capacity, circbuf_spsc_t **ring);
+*   returns             : ERR_SUCCESS if successful, or another error if failed
+*   capacity            : Capacity of the buffer
+*   ring                : Location to put the new buffer
+* Author                : Ben Heberlein
+* Date                  : 10/17/2026
+* Description           : Initialize a new single producer, single consumer buffer
+***********************************************************/
+circbuf_err_t circbuf_spsc_allocate(circbuf_count_t capacity, circbuf_spsc_t **ring) {
+    if (ring == NULL) {
+        return ERR_NULLPTR;
+    }
+
+    if (capacity == 0 || capacity > MAX_CAP) {
+        return ERR_CONFIG;
+    }
+
+    // Head and tail need their alignment, so plain malloc will not do
+    *ring = (circbuf_spsc_t *) aligned_alloc(CIRCBUF_CACHE_LINE, sizeof(circbuf_spsc_t));
+    if (*ring == NULL) {
+        return ERR_MEM;
+    }
+
+    // One extra slot so that head == tail always means empty
+    (*ring)->buf = circbuf_buf_alloc(capacity + 1, &(*ring)->map_len);
+    if ((*ring)->buf == NULL) {
+        free(*ring);
+        *ring = NULL;
+        return ERR_MEM;
+    }
+
+    (*ring)->slots = capacity + 1;
+    (*ring)->capacity = capacity;
+    atomic_init(&(*ring)->head, 0);
+    atomic_init(&(*ring)->tail, 0);
+    (*ring)->tail_cache = 0;
+    (*ring)->head_cache = 0;
+    atomic_init(&(*ring)->cons_waiting, 0);
+    atomic_init(&(*ring)->prod_waiting, 0);
+    (*ring)->prod_spin = SPIN_MIN;
+    (*ring)->cons_spin = SPIN_MIN;
+    CIRCBUF_STAT_INIT(*ring);
+
+#ifdef CIRCBUF_HAVE_WAIT
+    circbuf_membarrier_init();
+#endif
+
+    return ERR_SUCCESS;
+}
+
+/***********************************************************
+* circbuf_spsc_destroy : circbuf_err_t circbuf_spsc_destroy(circbuf_spsc_t *ring);
+*   returns            : ERR_SUCCESS for successful destroy or other error
+*   ring               : Buffer to destroy, must not be in use by either thread
+* Author               : Ben Heberlein
+* Date                 : 10/17/2026
+* Description          : Destroy an existing single producer, single consumer buffer
+***********************************************************/
+circbuf_err_t circbuf_spsc_destroy(circbuf_spsc_t *ring) {
+    if (ring == NULL) {
+        return ERR_NULLPTR;
+    }
+
+    circbuf_buf_free(ring->buf, ring->map_len);
+    free(ring);
+    return ERR_SUCCESS;
+}
+
+/***********************************************************
+* circbuf_spsc_add  : circbuf_err_t circbuf_spsc_add(uint32_t data, circbuf_spsc_t *ring);
+*   returns         : ERR_SUCCESS for success, ERR_FULL if full, or other error
+*   data            : The data to be added
+*   ring            : The buffer to be added to
+* Author            : Ben Heberlein
+* Date              : 10/17/2026
+* Description       : Add an item, may only be called from the producer thread
+***********************************************************/
+circbuf_err_t circbuf_spsc_add(uint32_t data, circbuf_spsc_t *ring) {
+    // Check if valid buffer
+    if (ring == NULL) {
+        return ERR_NULLPTR;
+    }
+
+    uint32_t head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+    uint32_t next = head + 1;
+    if (next == ring->slots) {
+        next = 0;
+    }
+
+    // Only go to the consumer's cache line when our copy says full
+    if (next == ring->tail_cache) {
+        ring->tail_cache = atomic_load_explicit(&ring->tail, memory_order_acquire);
+        if (next == ring->tail_cache) {
+#ifdef CIRCBUF_STATS
+            circbuf_stat_bump(&ring->prod_stats.full, 1);
+            circbuf_stat_high(&ring->prod_stats, ring->capacity);
+#endif
+            return ERR_FULL;
+        }
+    }
+
+    // Set data, then publish it to the consumer
+    ring->buf[head] = data;
+    atomic_store_explicit(&ring->head, next, memory_order_release);
+
+#ifdef CIRCBUF_STATS
+    // Sample the level from a fresh tail now and then, the cached
+    // copy lags and would make the buffer look fuller than it is
+    uint64_t adds = atomic_load_explicit(&ring->prod_stats.adds, memory_order_relaxed) + 1;
+    atomic_store_explicit(&ring->prod_stats.adds, adds, memory_order_relaxed);
+    if (adds % CIRCBUF_STATS_PERIOD == 0) {
+        ring->tail_cache = atomic_load_explicit(&ring->tail, memory_order_acquire);
+        uint32_t used = (next >= ring->tail_cache) ? next - ring->tail_cache
+                                                   : next + ring->slots - ring->tail_cache;
+        circbuf_stat_level(&ring->prod_stats, used);
+    }
+#endif
+
+#ifdef CIRCBUF_HAVE_WAIT
+    // Only set when the consumer went to sleep on an empty buffer
+    circbuf_barrier_fast();
+    if (atomic_load_explicit(&ring->cons_waiting, memory_order_relaxed)) {
+        circbuf_futex_wake(&ring->head);
     }
+#endif
+
+    return ERR_SUCCESS;
+}
 
-    return circular_buf->size;
+/***********************************************************
+* circbuf_spsc_remove : circbuf_err_t circbuf_spsc_remove(uint32_t *data, circbuf_spsc_t *ring);
+*   returns           : ERR_SUCCESS for success, ERR_EMPTY if empty, or other error
+*   data              : Pointer to where to put data
+*   ring              : The buffer to get data from
+* Author              : Ben Heberlein
+* Date                : 10/17/2026
+* Description         : Remove an item, may only be called from the consumer thread
+***********************************************************/
+circbuf_err_t circbuf_spsc_remove(uint32_t *data, circbuf_spsc_t *ring) {
+    // Check if valid buffer
+    if (ring == NULL || data == NULL) {
+        return ERR_NULLPTR;
+    }
+
+    uint32_t tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+
+    // Only go to the producer's cache line when our copy says empty
+    if (tail == ring->head_cache) {
+        ring->head_cache = atomic_load_explicit(&ring->head, memory_order_acquire);
+        if (tail == ring->head_cache) {
+            CIRCBUF_STAT_BUMP(ring->cons_stats.empty, 1);
+            return ERR_EMPTY;
+        }
+    }
+
+    // Get data, then hand the slot back to the producer
+    *data = ring->buf[tail];
+    tail++;
+    if (tail == ring->slots) {
+        tail = 0;
+    }
+    atomic_store_explicit(&ring->tail, tail, memory_order_release);
+    CIRCBUF_STAT_BUMP(ring->cons_stats.removes, 1);
+
+#ifdef CIRCBUF_HAVE_WAIT
+    // Only set when the producer went to sleep on a full buffer
+    circbuf_barrier_fast();
+    if (atomic_load_explicit(&ring->prod_waiting, memory_order_relaxed)) {
+        circbuf_futex_wake(&ring->tail);
+    }
+#endif
+
+    return ERR_SUCCESS;
 }
 
+/***********************************************************
+* circbuf_spsc_size  : circbuf_count_t circbuf_spsc_size(circbuf_spsc_t *ring);
+*   return           : number of items stored
+*   ring             : Buffer to get size of
+* Author             : Ben Heberlein
+* Date               : 10/17/2026
+* Description        : Returns the size of the buffer. When called while the
+*                      other side is running the result is only a snapshot.
+***********************************************************/
+circbuf_count_t circbuf_spsc_size(circbuf_spsc_t *ring) {
+    if (ring == NULL) {
+        return 0;
+    }
+
+    uint32_t head = atomic_load_explicit(&ring->head, memory_order_acquire);
+    uint32_t tail = atomic_load_explicit(&ring->tail, memory_order_acquire);
+
+    if (head >= tail) {
+        return (circbuf_count_t) (head - tail);
+    }
+    return (circbuf_count_t) (head + ring->slots - tail);
+}
+
+/***********************************************************
+* circbuf_spsc_stats : circbuf_err_t circbuf_spsc_stats(circbuf_stats_t *stats, circbuf_spsc_t *ring);
+*   return           : ERR_SUCCESS, ERR_CONFIG if built without CIRCBUF_STATS,
+*                      or other error
+*   stats            : Filled with a copy of the counters
+*   ring             : Buffer to read the counters of
+* Author             : Ben Heberlein
+* Date               : 10/17/2026
+* Description        : Copies out the occupancy and contention counters,
+*                      may be called from any thread
+***********************************************************/
+circbuf_err_t circbuf_spsc_stats(circbuf_stats_t *stats, circbuf_spsc_t *ring) {
+    if (stats == NULL || ring == NULL) {
+        return ERR_NULLPTR;
+    }
+
+#ifdef CIRCBUF_STATS
+    circbuf_stat_copy(stats, &ring->prod_stats, &ring->cons_stats);
+    return ERR_SUCCESS;
+#else
+    memset(stats, 0, sizeof(*stats));
+    return ERR_CONFIG;
+#endif
+}
+
+#ifdef CIRCBUF_HAVE_WAIT
+/***********************************************************
+* circbuf_spsc_add_timed : circbuf_err_t circbuf_spsc_add_timed(uint32_t data, uint64_t timeout_ns, circbuf_spsc_t *ring);
+*   returns              : ERR_SUCCESS for success, ERR_FULL on timeout, or other error
+*   data                 : The data to be added
+*   timeout_ns           : Longest time to wait in nanoseconds, or CIRCBUF_WAIT_FOREVER
+*   ring                 : The buffer to be added to
+* Author                 : Ben Heberlein
+* Date                   : 10/17/2026
+* Description            : Add an item, waiting for space if full. Spins for a
+*                          short, adaptive time and then sleeps until the
+*                          consumer takes an item out of the full buffer.
+*                          May only be called from the producer thread.
+***********************************************************/
+circbuf_err_t circbuf_spsc_add_timed(uint32_t data, uint64_t timeout_ns, circbuf_spsc_t *ring) {
+    // Check if valid buffer
+    if (ring == NULL) {
+        return ERR_NULLPTR;
+    }
+
+    // The consumer is often only a moment away, so spin first
+    for (uint32_t i = 0; i < ring->prod_spin; i++) {
+        if (circbuf_spsc_add(data, ring) == ERR_SUCCESS) {
+            if (i > 0 && ring->prod_spin < SPIN_MAX) {
+                ring->prod_spin *= 2;
+            }
+            return ERR_SUCCESS;
+        }
+        circbuf_cpu_relax();
+    }
+
+    // Spinning did not pay off, spin less next time
+    if (ring->prod_spin > SPIN_MIN) {
+        ring->prod_spin /= 2;
+    }
+
+    uint64_t deadline = circbuf_deadline(timeout_ns);
+
+    for (;;) {
+        if (circbuf_spsc_add(data, ring) == ERR_SUCCESS) {
+            return ERR_SUCCESS;
+        }
+
+        // Full means the consumer's tail sits right after our head
+        if (circbuf_spsc_sleep(&ring->tail, ring->tail_cache,
+                               &ring->prod_waiting, deadline)) {
+            return circbuf_spsc_add(data, ring);
+        }
+    }
+}
+
+/***********************************************************
+* circbuf_spsc_remove_timed : circbuf_err_t circbuf_spsc_remove_timed(uint32_t *data, uint64_t timeout_ns, circbuf_spsc_t *ring);
+*   returns                 : ERR_SUCCESS for success, ERR_EMPTY on timeout, or other error
+*   data                    : Pointer to where to put data
+*   timeout_ns              : Longest time to wait in nanoseconds, or CIRCBUF_WAIT_FOREVER
+*   ring                    : The buffer to get data from
+* Author                    : Ben Heberlein
+* Date                      : 10/17/2026
+* Description               : Remove an item, waiting for one if empty. Spins for
+*                             a short, adaptive time and then sleeps until the
+*                             producer adds to the empty buffer. May only be
+*                             called from the consumer thread.
+***********************************************************/
+circbuf_err_t circbuf_spsc_remove_timed(uint32_t *data, uint64_t timeout_ns, circbuf_spsc_t *ring) {
+    // Check if valid buffer
+    if (ring == NULL || data == NULL) {
+        return ERR_NULLPTR;
+    }
+
+    // The producer is often only a moment away, so spin first
+    for (uint32_t i = 0; i < ring->cons_spin; i++) {
+        if (circbuf_spsc_remove(data, ring) == ERR_SUCCESS) {
+            if (i > 0 && ring->cons_spin < SPIN_MAX) {
+                ring->cons_spin *= 2;
+            }
+            return ERR_SUCCESS;
+        }
+        circbuf_cpu_relax();
+    }
+
+    // Spinning did not pay off, spin less next time
+    if (ring->cons_spin > SPIN_MIN) {
+        ring->cons_spin /= 2;
+    }
+
+    uint64_t deadline = circbuf_deadline(timeout_ns);
+
+    for (;;) {
+        if (circbuf_spsc_remove(data, ring) == ERR_SUCCESS) {
+            return ERR_SUCCESS;
+        }
+
+        // Empty means the producer's head equals our tail
+        if (circbuf_spsc_sleep(&ring->head,
+                               atomic_load_explicit(&ring->tail, memory_order_relaxed),
+                               &ring->cons_waiting, deadline)) {
+            return circbuf_spsc_remove(data, ring);
+        }
+    }
+}
+
+/***********************************************************
+* circbuf_spsc_add_wait : circbuf_err_t circbuf_spsc_add_wait(uint32_t data, circbuf_spsc_t *ring);
+*   returns             : ERR_SUCCESS for success, or other error
+*   data                : The data to be added
+*   ring                : The buffer to be added to
+* Author                : Ben Heberlein
+* Date                  : 10/17/2026
+* Description           : Add an item, waiting as long as it takes for space
+***********************************************************/
+circbuf_err_t circbuf_spsc_add_wait(uint32_t data, circbuf_spsc_t *ring) {
+    return circbuf_spsc_add_timed(data, CIRCBUF_WAIT_FOREVER, ring);
+}
+
+/***********************************************************
+* circbuf_spsc_remove_wait : circbuf_err_t circbuf_spsc_remove_wait(uint32_t *data, circbuf_spsc_t *ring);
+*   returns                : ERR_SUCCESS for success, or other error
+*   data                   : Pointer to where to put data
+*   ring                   : The buffer to get data from
+* Author                   : Ben Heberlein
+* Date                     : 10/17/2026
+* Description              : Remove an item, waiting as long as it takes for one
+***********************************************************/
+circbuf_err_t circbuf_spsc_remove_wait(uint32_t *data, circbuf_spsc_t *ring) {
+    return circbuf_spsc_remove_timed(data, CIRCBUF_WAIT_FOREVER, ring);
+}
+#endif
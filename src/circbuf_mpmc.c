@@ -0,0 +1,206 @@
+/**********************************************************
+* Name: circbuf_mpmc.c
+*
+* Date: 10/17/2026
+*
+* Author: Ben Heberlein
+*
+* Description: This file implements a bounded multi
+* producer, multi consumer circular buffer using per slot
+* sequence numbers.
+*
+**********************************************************/
+
+#include <stdint.h>
+#include <stdlib.h>
+#include "circbuf_mpmc.h"
+
+#define MPMC_MAX_CAP 0x80000000UL
+
+/***********************************************************
+* circbuf_mpmc_allocate : circbuf_err_t circbuf_mpmc_allocate(circbuf_count_t capacity, circbuf_mpmc_t **queue);
+*   returns             : ERR_SUCCESS if successful, or another error if failed
+*   capacity            : Capacity of the buffer, must be a power of two
+*   queue               : Location to put the new buffer
+* Author                : Ben Heberlein
+* Date                  : 10/17/2026
+* Description           : Initialize a new multi producer, multi consumer buffer
+***********************************************************/
+circbuf_err_t circbuf_mpmc_allocate(circbuf_count_t capacity, circbuf_mpmc_t **queue) {
+    if (queue == NULL) {
+        return ERR_NULLPTR;
+    }
+
+    // Positions wrap with a mask and are compared as signed differences
+    if (capacity < 2 || (capacity & (capacity - 1)) != 0) {
+        return ERR_CONFIG;
+    }
+
+#ifndef CIRCBUF_EMBEDDED
+    // A 16 bit count can never go past the limit
+    if (capacity > MPMC_MAX_CAP) {
+        return ERR_CONFIG;
+    }
+#endif
+
+    *queue = (circbuf_mpmc_t *) aligned_alloc(CIRCBUF_CACHE_LINE, sizeof(circbuf_mpmc_t));
+    if (*queue == NULL) {
+        return ERR_MEM;
+    }
+
+    size_t bytes = capacity * sizeof(circbuf_mpmc_cell_t);
+    bytes = (bytes + CIRCBUF_CACHE_LINE - 1) & ~((size_t) CIRCBUF_CACHE_LINE - 1);
+    (*queue)->cells = (circbuf_mpmc_cell_t *) aligned_alloc(CIRCBUF_CACHE_LINE, bytes);
+    if ((*queue)->cells == NULL) {
+        free(*queue);
+        *queue = NULL;
+        return ERR_MEM;
+    }
+
+    // Slot i is first filled by enqueue position i
+    for (circbuf_count_t i = 0; i < capacity; i++) {
+        atomic_init(&(*queue)->cells[i].seq, (uint32_t) i);
+    }
+
+    (*queue)->mask = (uint32_t) (capacity - 1);
+    (*queue)->capacity = capacity;
+    atomic_init(&(*queue)->enqueue_pos, 0);
+    atomic_init(&(*queue)->dequeue_pos, 0);
+
+    return ERR_SUCCESS;
+}
+
+/***********************************************************
+* circbuf_mpmc_destroy : circbuf_err_t circbuf_mpmc_destroy(circbuf_mpmc_t *queue);
+*   returns            : ERR_SUCCESS for successful destroy or other error
+*   queue              : Buffer to destroy, must not be in use by any thread
+* Author               : Ben Heberlein
+* Date                 : 10/17/2026
+* Description          : Destroy an existing multi producer, multi consumer buffer
+***********************************************************/
+circbuf_err_t circbuf_mpmc_destroy(circbuf_mpmc_t *queue) {
+    if (queue == NULL) {
+        return ERR_NULLPTR;
+    }
+
+    free(queue->cells);
+    free(queue);
+    return ERR_SUCCESS;
+}
+
+/***********************************************************
+* circbuf_mpmc_add  : circbuf_err_t circbuf_mpmc_add(uint32_t data, circbuf_mpmc_t *queue);
+*   returns         : ERR_SUCCESS for success, ERR_FULL if full, or other error
+*   data            : The data to be added
+*   queue           : The buffer to be added to
+* Author            : Ben Heberlein
+* Date              : 10/17/2026
+* Description       : Add an item, safe to call from any number of threads
+***********************************************************/
+circbuf_err_t circbuf_mpmc_add(uint32_t data, circbuf_mpmc_t *queue) {
+    // Check if valid buffer
+    if (queue == NULL) {
+        return ERR_NULLPTR;
+    }
+
+    circbuf_mpmc_cell_t *cell;
+    uint32_t pos = atomic_load_explicit(&queue->enqueue_pos, memory_order_relaxed);
+
+    for (;;) {
+        cell = &queue->cells[pos & queue->mask];
+        uint32_t seq = atomic_load_explicit(&cell->seq, memory_order_acquire);
+        int32_t diff = (int32_t) (seq - pos);
+
+        if (diff == 0) {
+            // Slot is free for this position, try to claim it
+            if (atomic_compare_exchange_weak_explicit(&queue->enqueue_pos, &pos, pos + 1,
+                                                      memory_order_relaxed,
+                                                      memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            // Slot still holds data from the previous lap
+            return ERR_FULL;
+        } else {
+            // Another producer got here first
+            pos = atomic_load_explicit(&queue->enqueue_pos, memory_order_relaxed);
+        }
+    }
+
+    // Set data, then hand the slot to the consumers
+    cell->data = data;
+    atomic_store_explicit(&cell->seq, pos + 1, memory_order_release);
+
+    return ERR_SUCCESS;
+}
+
+/***********************************************************
+* circbuf_mpmc_remove : circbuf_err_t circbuf_mpmc_remove(uint32_t *data, circbuf_mpmc_t *queue);
+*   returns           : ERR_SUCCESS for success, ERR_EMPTY if empty, or other error
+*   data              : Pointer to where to put data
+*   queue             : The buffer to get data from
+* Author              : Ben Heberlein
+* Date                : 10/17/2026
+* Description         : Remove an item, safe to call from any number of threads
+***********************************************************/
+circbuf_err_t circbuf_mpmc_remove(uint32_t *data, circbuf_mpmc_t *queue) {
+    // Check if valid buffer
+    if (queue == NULL || data == NULL) {
+        return ERR_NULLPTR;
+    }
+
+    circbuf_mpmc_cell_t *cell;
+    uint32_t pos = atomic_load_explicit(&queue->dequeue_pos, memory_order_relaxed);
+
+    for (;;) {
+        cell = &queue->cells[pos & queue->mask];
+        uint32_t seq = atomic_load_explicit(&cell->seq, memory_order_acquire);
+        int32_t diff = (int32_t) (seq - (pos + 1));
+
+        if (diff == 0) {
+            // Slot holds data for this position, try to claim it
+            if (atomic_compare_exchange_weak_explicit(&queue->dequeue_pos, &pos, pos + 1,
+                                                      memory_order_relaxed,
+                                                      memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            // Nothing written here yet
+            return ERR_EMPTY;
+        } else {
+            // Another consumer got here first
+            pos = atomic_load_explicit(&queue->dequeue_pos, memory_order_relaxed);
+        }
+    }
+
+    // Get data, then hand the slot to the producer of the next lap
+    *data = cell->data;
+    atomic_store_explicit(&cell->seq, pos + queue->mask + 1, memory_order_release);
+
+    return ERR_SUCCESS;
+}
+
+/***********************************************************
+* circbuf_mpmc_size  : circbuf_count_t circbuf_mpmc_size(circbuf_mpmc_t *queue);
+*   return           : number of items stored
+*   queue            : Buffer to get size of
+* Author             : Ben Heberlein
+* Date               : 10/17/2026
+* Description        : Returns the size of the buffer. While other threads
+*                      are running the result is only a snapshot.
+***********************************************************/
+circbuf_count_t circbuf_mpmc_size(circbuf_mpmc_t *queue) {
+    if (queue == NULL) {
+        return 0;
+    }
+
+    uint32_t out = atomic_load_explicit(&queue->dequeue_pos, memory_order_acquire);
+    uint32_t in = atomic_load_explicit(&queue->enqueue_pos, memory_order_acquire);
+    uint32_t size = in - out;
+
+    // The two loads are not taken together, keep the answer in range
+    if (size > queue->capacity) {
+        size = (uint32_t) queue->capacity;
+    }
+    return (circbuf_count_t) size;
+}
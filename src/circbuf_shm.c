@@ -0,0 +1,568 @@
+/**********************************************************
+* Name: circbuf_shm.c
+*
+* Date: 10/17/2026
+*
+* Author: Ben Heberlein
+*
+* Description: This file implements a single producer,
+* single consumer message channel in POSIX shared memory.
+*
+**********************************************************/
+
+#ifndef CIRCBUF_EMBEDDED
+#define _GNU_SOURCE
+#endif
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "circbuf_shm.h"
+
+#ifdef CIRCBUF_HAVE_SHM
+#include <fcntl.h>
+#include <limits.h>
+#include <poll.h>
+#include <sched.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#define SHM_MIN_CAP 64UL
+#define SHM_MAX_CAP 0x80000000UL
+#define SPIN_MIN 16
+#define SPIN_MAX 4096
+
+static inline void circbuf_shm_cpu_relax(void) {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    __asm__ __volatile__("yield");
+#endif
+}
+
+static uint64_t circbuf_shm_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000000000ULL + (uint64_t) ts.tv_nsec;
+}
+
+static uint64_t circbuf_shm_deadline(uint64_t timeout_ns) {
+    if (timeout_ns == CIRCBUF_WAIT_FOREVER) {
+        return CIRCBUF_WAIT_FOREVER;
+    }
+
+    uint64_t now = circbuf_shm_now_ns();
+    if (timeout_ns >= CIRCBUF_WAIT_FOREVER - now) {
+        return CIRCBUF_WAIT_FOREVER - 1;
+    }
+    return now + timeout_ns;
+}
+
+static inline uint64_t circbuf_shm_frame(uint64_t len) {
+    return CIRCBUF_SHM_FRAME_HDR + ((len + 7) & ~(uint64_t) 7);
+}
+
+/***********************************************************
+* circbuf_shm_view   : static circbuf_err_t circbuf_shm_view(circbuf_shm_hdr_t *hdr, size_t map_len, circbuf_shm_t **channel);
+*   returns          : ERR_SUCCESS if successful, or ERR_MEM with the mapping released
+*   hdr              : Start of a checked mapping
+*   map_len          : Length of the mapping
+*   channel          : Location to put the new handle
+* Description        : Make a process local handle for a mapped channel
+***********************************************************/
+static circbuf_err_t circbuf_shm_view(circbuf_shm_hdr_t *hdr, size_t map_len,
+                                      circbuf_shm_t **channel) {
+    *channel = (circbuf_shm_t *) malloc(sizeof(circbuf_shm_t));
+    if (*channel == NULL) {
+        munmap(hdr, map_len);
+        return ERR_MEM;
+    }
+
+    (*channel)->hdr = hdr;
+    (*channel)->data = (uint8_t *) hdr + hdr->data_offset;
+    (*channel)->map_len = map_len;
+    (*channel)->mask = hdr->capacity - 1;
+    (*channel)->head_cache = atomic_load_explicit(&hdr->head, memory_order_acquire);
+    (*channel)->tail_cache = atomic_load_explicit(&hdr->tail, memory_order_acquire);
+    (*channel)->spin = SPIN_MIN;
+    (*channel)->data_fd = -1;
+    (*channel)->space_fd = -1;
+
+    return ERR_SUCCESS;
+}
+
+/***********************************************************
+* circbuf_shm_notify : static inline void circbuf_shm_notify(_Atomic uint32_t *waiting, int fd);
+*   waiting          : The other side's waiting flag
+*   fd               : The eventfd the other side sleeps on
+* Description        : Wake the other side if it went to sleep. The fence
+*                      pairs with the one in circbuf_shm_wait, so either
+*                      the sleeper sees the new position or we see its flag.
+*                      The two sides are in different processes, so unlike
+*                      circbuf_spsc_t this can not be moved onto the sleeper
+*                      with membarrier.
+***********************************************************/
+static inline void circbuf_shm_notify(_Atomic uint32_t *waiting, int fd) {
+    if (fd < 0) {
+        return;
+    }
+
+    atomic_thread_fence(memory_order_seq_cst);
+    if (atomic_load_explicit(waiting, memory_order_relaxed)) {
+        uint64_t one = 1;
+        if (write(fd, &one, sizeof(one)) < 0) {
+            // The counter is already non zero, the sleeper will wake
+        }
+    }
+}
+
+/***********************************************************
+* circbuf_shm_wait   : static int circbuf_shm_wait(circbuf_shm_t *channel, _Atomic uint64_t *word, uint64_t seen, _Atomic uint32_t *waiting, int fd, uint64_t deadline);
+*   returns          : 1 if the deadline has passed, 0 otherwise
+*   channel          : The channel being waited on
+*   word             : The other side's position
+*   seen             : The value it has while we can not go on
+*   waiting          : Our flag in the other side's cache line
+*   fd               : Eventfd to sleep on, or -1 to yield instead
+*   deadline         : Absolute CLOCK_MONOTONIC time in ns, or CIRCBUF_WAIT_FOREVER
+* Description        : Wait until the other side moves its position. May
+*                      return early, so callers retry in a loop.
+***********************************************************/
+static int circbuf_shm_wait(circbuf_shm_t *channel, _Atomic uint64_t *word, uint64_t seen,
+                            _Atomic uint32_t *waiting, int fd, uint64_t deadline) {
+    // Spin first, the budget grows when spinning pays off
+    for (uint32_t i = 0; i < channel->spin; i++) {
+        if (atomic_load_explicit(word, memory_order_relaxed) != seen) {
+            if (channel->spin < SPIN_MAX) {
+                channel->spin *= 2;
+            }
+            return 0;
+        }
+        circbuf_shm_cpu_relax();
+    }
+    if (channel->spin > SPIN_MIN) {
+        channel->spin /= 2;
+    }
+
+    uint64_t now = circbuf_shm_now_ns();
+    if (deadline != CIRCBUF_WAIT_FOREVER && now >= deadline) {
+        return 1;
+    }
+
+    if (fd < 0) {
+        sched_yield();
+        return 0;
+    }
+
+    int ms = -1;
+    if (deadline != CIRCBUF_WAIT_FOREVER) {
+        uint64_t rel = (deadline - now + 999999) / 1000000;
+        ms = rel > INT_MAX ? INT_MAX : (int) rel;
+    }
+
+    // Either the other side sees the flag or we see its new position
+    atomic_store_explicit(waiting, 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_seq_cst);
+    if (atomic_load_explicit(word, memory_order_relaxed) == seen) {
+        struct pollfd pfd = { .fd = fd, .events = POLLIN, .revents = 0 };
+        if (poll(&pfd, 1, ms) > 0) {
+            uint64_t count;
+            if (read(fd, &count, sizeof(count)) < 0) {
+                // Someone else cleared it, the position check decides
+            }
+        }
+    }
+    atomic_store_explicit(waiting, 0, memory_order_relaxed);
+
+    return 0;
+}
+
+/***********************************************************
+* circbuf_shm_create : circbuf_err_t circbuf_shm_create(const char *name, size_t capacity, uint32_t flags, circbuf_shm_t **channel);
+*   returns          : ERR_SUCCESS if successful, or another error if failed
+*   name             : POSIX shared memory name, like "/my_channel"
+*   capacity         : Bytes in the ring, a power of two of at least 64
+*   flags            : Or of circbuf_shm_flag_t values
+*   channel          : Location to put the new handle
+* Author             : Ben Heberlein
+* Date               : 10/17/2026
+* Description        : Create a new channel. Fails if the name is already in
+*                      use. The eventfds of a CIRCBUF_SHM_EVENTFD channel
+*                      are shared with children made by fork, other
+*                      processes have to be given them with
+*                      circbuf_shm_set_eventfd.
+***********************************************************/
+circbuf_err_t circbuf_shm_create(const char *name, size_t capacity, uint32_t flags,
+                                 circbuf_shm_t **channel) {
+    if (name == NULL || channel == NULL) {
+        return ERR_NULLPTR;
+    }
+
+    // Frame lengths are 32 bit and positions are masked
+    if (capacity < SHM_MIN_CAP || capacity > SHM_MAX_CAP || (capacity & (capacity - 1)) != 0) {
+        return ERR_CONFIG;
+    }
+    if (flags & ~(uint32_t) CIRCBUF_SHM_EVENTFD) {
+        return ERR_CONFIG;
+    }
+
+    int fd = shm_open(name, O_RDWR | O_CREAT | O_EXCL, 0600);
+    if (fd < 0) {
+        return ERR_UNKNOWN;
+    }
+
+    size_t map_len = sizeof(circbuf_shm_hdr_t) + capacity;
+    if (ftruncate(fd, (off_t) map_len) != 0) {
+        close(fd);
+        shm_unlink(name);
+        return ERR_MEM;
+    }
+
+    circbuf_shm_hdr_t *hdr = (circbuf_shm_hdr_t *) mmap(NULL, map_len, PROT_READ | PROT_WRITE,
+                                                        MAP_SHARED, fd, 0);
+    close(fd);
+    if (hdr == MAP_FAILED) {
+        shm_unlink(name);
+        return ERR_MEM;
+    }
+
+    // The object is zero filled, magic goes in last so openers never see half a header
+    hdr->version = CIRCBUF_SHM_VERSION;
+    hdr->capacity = capacity;
+    hdr->data_offset = sizeof(circbuf_shm_hdr_t);
+    hdr->flags = flags;
+    atomic_init(&hdr->head, 0);
+    atomic_init(&hdr->cons_waiting, 0);
+    atomic_init(&hdr->tail, 0);
+    atomic_init(&hdr->prod_waiting, 0);
+    atomic_thread_fence(memory_order_release);
+    hdr->magic = CIRCBUF_SHM_MAGIC;
+
+    circbuf_err_t err = circbuf_shm_view(hdr, map_len, channel);
+    if (err != ERR_SUCCESS) {
+        shm_unlink(name);
+        return err;
+    }
+
+    if (flags & CIRCBUF_SHM_EVENTFD) {
+        (*channel)->data_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        (*channel)->space_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if ((*channel)->data_fd < 0 || (*channel)->space_fd < 0) {
+            circbuf_shm_close(*channel);
+            *channel = NULL;
+            shm_unlink(name);
+            return ERR_UNKNOWN;
+        }
+    }
+
+    return ERR_SUCCESS;
+}
+
+/***********************************************************
+* circbuf_shm_open   : circbuf_err_t circbuf_shm_open(const char *name, circbuf_shm_t **channel);
+*   returns          : ERR_SUCCESS if successful, or another error if failed
+*   name             : Name the channel was created with
+*   channel          : Location to put the new handle
+* Author             : Ben Heberlein
+* Date               : 10/17/2026
+* Description        : Open a channel made by another process
+***********************************************************/
+circbuf_err_t circbuf_shm_open(const char *name, circbuf_shm_t **channel) {
+    if (name == NULL || channel == NULL) {
+        return ERR_NULLPTR;
+    }
+
+    int fd = shm_open(name, O_RDWR, 0);
+    if (fd < 0) {
+        return ERR_UNKNOWN;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        close(fd);
+        return ERR_UNKNOWN;
+    }
+    if ((size_t) st.st_size < sizeof(circbuf_shm_hdr_t)) {
+        close(fd);
+        return ERR_CONFIG;
+    }
+
+    size_t map_len = (size_t) st.st_size;
+    circbuf_shm_hdr_t *hdr = (circbuf_shm_hdr_t *) mmap(NULL, map_len, PROT_READ | PROT_WRITE,
+                                                        MAP_SHARED, fd, 0);
+    close(fd);
+    if (hdr == MAP_FAILED) {
+        return ERR_MEM;
+    }
+
+    // Check everything the handle relies on before trusting it
+    uint32_t magic = hdr->magic;
+    atomic_thread_fence(memory_order_acquire);
+    if (magic != CIRCBUF_SHM_MAGIC ||
+        hdr->version != CIRCBUF_SHM_VERSION ||
+        hdr->capacity < SHM_MIN_CAP || hdr->capacity > SHM_MAX_CAP ||
+        (hdr->capacity & (hdr->capacity - 1)) != 0 ||
+        hdr->data_offset < sizeof(circbuf_shm_hdr_t) ||
+        hdr->data_offset + hdr->capacity > map_len) {
+        munmap(hdr, map_len);
+        return ERR_CONFIG;
+    }
+
+    return circbuf_shm_view(hdr, map_len, channel);
+}
+
+/***********************************************************
+* circbuf_shm_close  : circbuf_err_t circbuf_shm_close(circbuf_shm_t *channel);
+*   returns          : ERR_SUCCESS for successful close or other error
+*   channel          : Handle to close
+* Author             : Ben Heberlein
+* Date               : 10/17/2026
+* Description        : Unmap the channel and close its eventfds. The shared
+*                      memory object stays until circbuf_shm_unlink.
+***********************************************************/
+circbuf_err_t circbuf_shm_close(circbuf_shm_t *channel) {
+    if (channel == NULL) {
+        return ERR_NULLPTR;
+    }
+
+    if (channel->data_fd >= 0) {
+        close(channel->data_fd);
+    }
+    if (channel->space_fd >= 0) {
+        close(channel->space_fd);
+    }
+    munmap(channel->hdr, channel->map_len);
+    free(channel);
+
+    return ERR_SUCCESS;
+}
+
+/***********************************************************
+* circbuf_shm_unlink : circbuf_err_t circbuf_shm_unlink(const char *name);
+*   returns          : ERR_SUCCESS if successful, or another error if failed
+*   name             : Name the channel was created with
+* Author             : Ben Heberlein
+* Date               : 10/17/2026
+* Description        : Remove the name. Open handles keep working.
+***********************************************************/
+circbuf_err_t circbuf_shm_unlink(const char *name) {
+    if (name == NULL) {
+        return ERR_NULLPTR;
+    }
+
+    return shm_unlink(name) == 0 ? ERR_SUCCESS : ERR_UNKNOWN;
+}
+
+/***********************************************************
+* circbuf_shm_set_eventfd : circbuf_err_t circbuf_shm_set_eventfd(circbuf_shm_t *channel, int data_fd, int space_fd);
+*   returns               : ERR_SUCCESS if successful, or another error if failed
+*   channel               : Handle opened with circbuf_shm_open
+*   data_fd               : The creator's data eventfd
+*   space_fd              : The creator's space eventfd
+* Author                  : Ben Heberlein
+* Date                    : 10/17/2026
+* Description             : Give a handle the eventfds of a CIRCBUF_SHM_EVENTFD
+*                           channel, usually received over a unix socket. The
+*                           handle owns them from then on.
+***********************************************************/
+circbuf_err_t circbuf_shm_set_eventfd(circbuf_shm_t *channel, int data_fd, int space_fd) {
+    if (channel == NULL) {
+        return ERR_NULLPTR;
+    }
+
+    if (!(channel->hdr->flags & CIRCBUF_SHM_EVENTFD) || data_fd < 0 || space_fd < 0 ||
+        channel->data_fd >= 0 || channel->space_fd >= 0) {
+        return ERR_CONFIG;
+    }
+
+    channel->data_fd = data_fd;
+    channel->space_fd = space_fd;
+    return ERR_SUCCESS;
+}
+
+/***********************************************************
+* circbuf_shm_send   : circbuf_err_t circbuf_shm_send(circbuf_shm_t *channel, const void *msg, size_t len);
+*   returns          : ERR_SUCCESS for success, ERR_FULL if there is no room,
+*                      ERR_CONFIG if len is over capacity / 2 - 8, or other error
+*   channel          : The channel to send on
+*   msg              : Message bytes
+*   len              : Length of the message, may be 0
+* Author             : Ben Heberlein
+* Date               : 10/17/2026
+* Description        : Copy a message into the ring without waiting. May only
+*                      be called from the producer process.
+***********************************************************/
+circbuf_err_t circbuf_shm_send(circbuf_shm_t *channel, const void *msg, size_t len) {
+    // Check if valid data
+    if (channel == NULL || (msg == NULL && len != 0)) {
+        return ERR_NULLPTR;
+    }
+
+    // Up to half the ring a frame plus its pad always fits once the ring drains
+    uint64_t capacity = channel->mask + 1;
+    if (len > capacity / 2 - CIRCBUF_SHM_FRAME_HDR) {
+        return ERR_CONFIG;
+    }
+
+    circbuf_shm_hdr_t *hdr = channel->hdr;
+    uint64_t frame = circbuf_shm_frame(len);
+    uint64_t head = atomic_load_explicit(&hdr->head, memory_order_relaxed);
+    uint64_t off = head & channel->mask;
+    uint64_t pad = (capacity - off < frame) ? capacity - off : 0;
+
+    // Only look at the consumer's line when the cached tail says full
+    if (head + pad + frame - channel->tail_cache > capacity) {
+        channel->tail_cache = atomic_load_explicit(&hdr->tail, memory_order_acquire);
+        if (head + pad + frame - channel->tail_cache > capacity) {
+            return ERR_FULL;
+        }
+    }
+
+    if (pad) {
+        *(uint32_t *) (channel->data + off) = CIRCBUF_SHM_PAD;
+        off = 0;
+    }
+
+    uint32_t *fhdr = (uint32_t *) (channel->data + off);
+    fhdr[0] = (uint32_t) len;
+    fhdr[1] = 0;
+    if (len) {
+        memcpy(channel->data + off + CIRCBUF_SHM_FRAME_HDR, msg, len);
+    }
+
+    // Publish the pad and the frame together
+    atomic_store_explicit(&hdr->head, head + pad + frame, memory_order_release);
+    circbuf_shm_notify(&hdr->cons_waiting, channel->data_fd);
+
+    return ERR_SUCCESS;
+}
+
+/***********************************************************
+* circbuf_shm_recv   : circbuf_err_t circbuf_shm_recv(circbuf_shm_t *channel, void *buf, size_t size, size_t *len);
+*   returns          : ERR_SUCCESS for success, ERR_EMPTY if there is no message,
+*                      ERR_MEM if buf is too small, or other error
+*   channel          : The channel to receive from
+*   buf              : Where to put the message
+*   size             : Size of buf
+*   len              : Set to the message length, also when buf is too small
+* Author             : Ben Heberlein
+* Date               : 10/17/2026
+* Description        : Copy the next message out of the ring without waiting.
+*                      A message that does not fit stays in the ring. May only
+*                      be called from the consumer process.
+***********************************************************/
+circbuf_err_t circbuf_shm_recv(circbuf_shm_t *channel, void *buf, size_t size, size_t *len) {
+    // Check if valid data
+    if (channel == NULL || len == NULL || (buf == NULL && size != 0)) {
+        return ERR_NULLPTR;
+    }
+
+    circbuf_shm_hdr_t *hdr = channel->hdr;
+    uint64_t capacity = channel->mask + 1;
+    uint64_t tail = atomic_load_explicit(&hdr->tail, memory_order_relaxed);
+
+    // Only look at the producer's line when the cached head says empty
+    if (tail == channel->head_cache) {
+        channel->head_cache = atomic_load_explicit(&hdr->head, memory_order_acquire);
+        if (tail == channel->head_cache) {
+            return ERR_EMPTY;
+        }
+    }
+
+    uint64_t off = tail & channel->mask;
+    uint32_t flen = *(uint32_t *) (channel->data + off);
+
+    // A pad is always published together with the frame after it
+    if (flen == CIRCBUF_SHM_PAD) {
+        tail += capacity - off;
+        off = 0;
+        flen = *(uint32_t *) channel->data;
+    }
+
+    // The ring is shared with another process, do not trust it blindly. The
+    // frame has to fit before the end of the mapping and be fully published
+    if (flen > capacity / 2 - CIRCBUF_SHM_FRAME_HDR ||
+        off + CIRCBUF_SHM_FRAME_HDR + flen > capacity ||
+        tail + circbuf_shm_frame(flen) > channel->head_cache) {
+        return ERR_UNKNOWN;
+    }
+
+    *len = flen;
+    if (flen > size) {
+        return ERR_MEM;
+    }
+    if (flen) {
+        memcpy(buf, channel->data + off + CIRCBUF_SHM_FRAME_HDR, flen);
+    }
+
+    atomic_store_explicit(&hdr->tail, tail + circbuf_shm_frame(flen), memory_order_release);
+    circbuf_shm_notify(&hdr->prod_waiting, channel->space_fd);
+
+    return ERR_SUCCESS;
+}
+
+/***********************************************************
+* circbuf_shm_send_timed : circbuf_err_t circbuf_shm_send_timed(circbuf_shm_t *channel, const void *msg, size_t len, uint64_t timeout_ns);
+*   returns              : ERR_SUCCESS for success, ERR_FULL on timeout, or other error
+*   channel              : The channel to send on
+*   msg                  : Message bytes
+*   len                  : Length of the message
+*   timeout_ns           : Longest time to wait in nanoseconds, or CIRCBUF_WAIT_FOREVER
+* Author                 : Ben Heberlein
+* Date                   : 10/17/2026
+* Description            : Send a message, waiting for room. Spins for a short,
+*                          adaptive time, then sleeps on the space eventfd if
+*                          there is one and yields the CPU if not.
+***********************************************************/
+circbuf_err_t circbuf_shm_send_timed(circbuf_shm_t *channel, const void *msg, size_t len,
+                                     uint64_t timeout_ns) {
+    uint64_t deadline = circbuf_shm_deadline(timeout_ns);
+
+    for (;;) {
+        circbuf_err_t err = circbuf_shm_send(channel, msg, len);
+        if (err != ERR_FULL) {
+            return err;
+        }
+
+        // A failed send just refreshed tail_cache
+        if (circbuf_shm_wait(channel, &channel->hdr->tail, channel->tail_cache,
+                             &channel->hdr->prod_waiting, channel->space_fd, deadline)) {
+            return ERR_FULL;
+        }
+    }
+}
+
+/***********************************************************
+* circbuf_shm_recv_timed : circbuf_err_t circbuf_shm_recv_timed(circbuf_shm_t *channel, void *buf, size_t size, size_t *len, uint64_t timeout_ns);
+*   returns              : ERR_SUCCESS for success, ERR_EMPTY on timeout, or other error
+*   channel              : The channel to receive from
+*   buf                  : Where to put the message
+*   size                 : Size of buf
+*   len                  : Set to the message length
+*   timeout_ns           : Longest time to wait in nanoseconds, or CIRCBUF_WAIT_FOREVER
+* Author                 : Ben Heberlein
+* Date                   : 10/17/2026
+* Description            : Receive a message, waiting for one to arrive. Waits
+*                          the same way as circbuf_shm_send_timed.
+***********************************************************/
+circbuf_err_t circbuf_shm_recv_timed(circbuf_shm_t *channel, void *buf, size_t size, size_t *len,
+                                     uint64_t timeout_ns) {
+    uint64_t deadline = circbuf_shm_deadline(timeout_ns);
+
+    for (;;) {
+        circbuf_err_t err = circbuf_shm_recv(channel, buf, size, len);
+        if (err != ERR_EMPTY) {
+            return err;
+        }
+
+        // A failed receive just refreshed head_cache
+        if (circbuf_shm_wait(channel, &channel->hdr->head, channel->head_cache,
+                             &channel->hdr->cons_waiting, channel->data_fd, deadline)) {
+            return ERR_EMPTY;
+        }
+    }
+}
+#endif
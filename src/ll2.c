@@ -27,185 +27,1199 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include "ll2.h"
+#include "ll2_index.h"
 
-ll2_err_t ll2_destroy(ll2_node_t **head) {
-    if (head == NULL) {
+/* One bin per power of two, enough for any list that fits in memory */
+#define LL2_SORT_BINS 64
+
+/**
+ * @brief A block of nodes allocated from the heap by a pool
+ */
+typedef struct ll2_slab_s {
+    struct ll2_slab_s *next;
+    ll2_node_t nodes[];
+} ll2_slab_t;
+
+/**
+ * @brief Points the pool at the unused nodes of a slab
+ *
+ * @param pool The pool to update
+ * @param slab The slab to carve from next
+ */
+static void ll2_pool_use_slab(ll2_pool_t *pool, ll2_slab_t *slab) {
+    pool->cur = slab;
+    pool->next_node = slab->nodes;
+    pool->end = slab->nodes + LL2_POOL_SLAB_NODES;
+}
+
+/**
+ * @brief Gets a node from a pool, or from malloc if there is no pool
+ *
+ * @param pool The pool to take from, or NULL
+ *
+ * @return The new node, or NULL if out of memory
+ */
+static ll2_node_t *ll2_node_alloc(ll2_pool_t *pool) {
+    if (pool == NULL) {
+        return (ll2_node_t *) malloc(sizeof(ll2_node_t));
+    }
+
+    /* Reuse freed nodes first */
+    ll2_node_t *node = pool->free_list;
+    if (node != NULL) {
+        pool->free_list = node->next;
+        return node;
+    }
+
+    if (pool->next_node == pool->end) {
+        /* Arena pools never grow */
+        if (pool->arena != NULL) {
+            return NULL;
+        }
+
+        /* Move on to a slab kept from before the last reset, or make one */
+        if (pool->cur != NULL && pool->cur->next != NULL) {
+            ll2_pool_use_slab(pool, pool->cur->next);
+        } else {
+            ll2_slab_t *slab = (ll2_slab_t *) malloc(sizeof(ll2_slab_t) +
+                                                     LL2_POOL_SLAB_NODES * sizeof(ll2_node_t));
+            if (slab == NULL) {
+                return NULL;
+            }
+            slab->next = NULL;
+            if (pool->cur == NULL) {
+                pool->slabs = slab;
+            } else {
+                pool->cur->next = slab;
+            }
+            ll2_pool_use_slab(pool, slab);
+        }
+    }
+
+    return pool->next_node++;
+}
+
+/**
+ * @brief Gives a node back to a pool, or to free if there is no pool
+ *
+ * @param pool The pool the node came from, or NULL
+ * @param node The node to release
+ */
+static void ll2_node_free(ll2_pool_t *pool, ll2_node_t *node) {
+    if (pool == NULL) {
+        free(node);
+        return;
+    }
+
+    node->next = pool->free_list;
+    pool->free_list = node;
+}
+
+/**
+ * @brief Makes every node of a pool unused again, keeping its memory
+ *
+ * @param pool The pool to reset
+ */
+static void ll2_pool_reset(ll2_pool_t *pool) {
+    pool->free_list = NULL;
+    pool->cur = NULL;
+
+    if (pool->arena != NULL) {
+        pool->next_node = pool->arena;
+        pool->end = pool->arena + pool->arena_nodes;
+    } else if (pool->slabs != NULL) {
+        ll2_pool_use_slab(pool, pool->slabs);
+    } else {
+        pool->next_node = NULL;
+        pool->end = NULL;
+    }
+}
+
+ll2_err_t ll2_pool_init(ll2_pool_t *pool, void *arena, size_t size) {
+    if (pool == NULL) {
         return LL2_NULLPTR;
     }
 
-    if (*head == NULL) {
-        return LL2_SUCCESS;
+    pool->slabs = NULL;
+    pool->arena = NULL;
+    pool->arena_nodes = 0;
+
+    if (arena != NULL) {
+        /* Line the first node up, then use as many whole nodes as fit */
+        uintptr_t start = (uintptr_t) arena;
+        uintptr_t aligned = (start + _Alignof(ll2_node_t) - 1) &
+                            ~(uintptr_t) (_Alignof(ll2_node_t) - 1);
+        if (size < aligned - start + sizeof(ll2_node_t)) {
+            return LL2_MEM;
+        }
+        pool->arena = (ll2_node_t *) aligned;
+        pool->arena_nodes = (size - (aligned - start)) / sizeof(ll2_node_t);
     }
 
-    ll2_node_t *temp_node = *head;
-    ll2_node_t *temp_node_2 = *head;
+    ll2_pool_reset(pool);
+    return LL2_SUCCESS;
+}
 
-    while(temp_node != NULL) {
-        temp_node_2 = temp_node->next;
-        free(temp_node);
-        temp_node = temp_node_2;
+ll2_err_t ll2_pool_destroy(ll2_pool_t *pool) {
+    if (pool == NULL) {
+        return LL2_NULLPTR;
     }
 
-    *head = NULL;
+    ll2_slab_t *slab = pool->slabs;
+    while (slab != NULL) {
+        ll2_slab_t *next = slab->next;
+        free(slab);
+        slab = next;
+    }
 
+    pool->slabs = NULL;
+    pool->arena = NULL;
+    pool->arena_nodes = 0;
+    ll2_pool_reset(pool);
     return LL2_SUCCESS;
 }
 
-ll2_err_t ll2_add_node(ll2_node_t **head, uint32_t data, uint16_t index) {
-    if (head == NULL) {
+ll2_err_t ll2_destroy_pool(ll2_node_t **head, ll2_pool_t *pool) {
+    if (head == NULL || pool == NULL) {
         return LL2_NULLPTR;
     }
 
-    uint16_t temp = 0;
-    ll2_node_t *temp_node = NULL;
+    ll2_pool_reset(pool);
+    *head = NULL;
+
+    return LL2_SUCCESS;
+}
+
+/**
+ * @brief Frees every node from a node onwards
+ *
+ * @param node The first node to free
+ * @param pool The pool the nodes came from, or NULL
+ */
+static void ll2_free_all(ll2_node_t *node, ll2_pool_t *pool) {
+    ll2_node_t *temp_node;
+
+    while(node != NULL) {
+        temp_node = node->next;
+        ll2_node_free(pool, node);
+        node = temp_node;
+    }
+}
+
+/**
+ * @brief Walks forward a number of nodes
+ *
+ * @param node The node to start at
+ * @param steps The number of nodes to jump
+ *
+ * @return The node reached, or NULL if the list ends first
+ */
+static ll2_node_t *ll2_walk(ll2_node_t *node, size_t steps) {
+    while(node != NULL && steps > 0) {
+        node = node->next;
+        steps--;
+    }
+
+    return node;
+}
+
+/**
+ * @brief Finds the node at an index of a list with known length
+ *
+ * Walks from whichever end of the list is closer.
+ *
+ * @param list The list to walk, index must be below list->count
+ * @param index The index of the node
+ *
+ * @return The node at index
+ */
+static ll2_node_t *ll2_list_node(ll2_list_t *list, size_t index) {
+    if (index < list->count / 2) {
+        return ll2_walk(list->head, index);
+    }
+
+    ll2_node_t *node = list->tail;
+    for (size_t steps = list->count - 1 - index; steps > 0; steps--) {
+        node = node->prev;
+    }
+    return node;
+}
+
+/**
+ * @brief Links a run of chained nodes in after another node
+ *
+ * @param head A double pointer to the linked list head
+ * @param prev The node to insert after, or NULL to insert at the head
+ * @param first The first node of the run
+ * @param last The last node of the run
+ */
+static void ll2_splice(ll2_node_t **head, ll2_node_t *prev, ll2_node_t *first, ll2_node_t *last) {
+    first->prev = prev;
+    if (prev == NULL) {
+        last->next = *head;
+        *head = first;
+    } else {
+        last->next = prev->next;
+        prev->next = first;
+    }
+    if (last->next != NULL) {
+        last->next->prev = last;
+    }
+}
+
+/**
+ * @brief Links a node in after another one
+ *
+ * @param head A double pointer to the linked list head
+ * @param prev The node to insert after, or NULL to insert at the head
+ * @param node The node to insert
+ */
+static void ll2_link(ll2_node_t **head, ll2_node_t *prev, ll2_node_t *node) {
+    ll2_splice(head, prev, node, node);
+}
+
+/**
+ * @brief Takes a run of nodes out of its list
+ *
+ * The run keeps its inner links and last->next is set to NULL, so it can be
+ * freed with ll2_free_all.
+ *
+ * @param head A double pointer to the linked list head
+ * @param first The first node of the run
+ * @param last The last node of the run
+ */
+static void ll2_cut(ll2_node_t **head, ll2_node_t *first, ll2_node_t *last) {
+    if (first->prev == NULL) {
+        *head = last->next;
+    } else {
+        first->prev->next = last->next;
+    }
+    if (last->next != NULL) {
+        last->next->prev = first->prev;
+    }
+    last->next = NULL;
+}
+
+/**
+ * @brief Takes a node out of its list
+ *
+ * @param head A double pointer to the linked list head
+ * @param node The node to remove
+ */
+static void ll2_unlink(ll2_node_t **head, ll2_node_t *node) {
+    ll2_cut(head, node, node);
+}
+
+/**
+ * @brief Builds a chained run of nodes holding an array of values
+ *
+ * On failure every node built so far is released again.
+ *
+ * @param values The values, in order
+ * @param count The number of values, at least 1
+ * @param pool The pool to take nodes from, or NULL
+ * @param first Set to the first node of the run
+ * @param last Set to the last node of the run
+ *
+ * @return LL2_SUCCESS, or LL2_MEM if a node could not be allocated
+ */
+static ll2_err_t ll2_build_run(const uint32_t *values, size_t count, ll2_pool_t *pool,
+                               ll2_node_t **first, ll2_node_t **last) {
+    ll2_node_t *prev = NULL;
 
-    /* Special case for index = 0 */
-    if (index == 0) {
-        temp_node = (ll2_node_t *) malloc(sizeof(ll2_node_t));
-        if (temp_node == NULL) {
+    *first = NULL;
+    for (size_t i = 0; i < count; i++) {
+        ll2_node_t *node = ll2_node_alloc(pool);
+        if (node == NULL) {
+            if (prev != NULL) {
+                prev->next = NULL;
+            }
+            ll2_free_all(*first, pool);
             return LL2_MEM;
         }
-        temp_node->prev = NULL;
+        node->data = values[i];
+        node->prev = prev;
+        if (prev == NULL) {
+            *first = node;
+        } else {
+            prev->next = node;
+        }
+        prev = node;
+    }
+    prev->next = NULL;
+    *last = prev;
+
+    return LL2_SUCCESS;
+}
+
+/**
+ * @brief Searches forward from a node for data
+ *
+ * @param node The first node to look at
+ * @param data The data to search for
+ * @param index A pointer to return the index of the data
+ *
+ * @return LL2_SUCCESS if found, LL2_DATA if not
+ */
+static ll2_err_t ll2_find(ll2_node_t *node, uint32_t data, size_t *index) {
+    size_t temp = 0;
+
+    while(node != NULL) {
+        if (node->data == data) {
+            *index = temp;
+            return LL2_SUCCESS;
+        }
+        node = node->next;
+        temp++;
+    }
+
+    return LL2_DATA;
+}
+
+/**
+ * @brief Merges two sorted runs chained by next only
+ *
+ * Where values are equal the nodes of a come first, which keeps sorting
+ * stable when a holds the earlier nodes. prev pointers are left for
+ * ll2_relink to fix.
+ *
+ * @param a The first run, or NULL
+ * @param b The second run, or NULL
+ *
+ * @return The first node of the merged run
+ */
+static ll2_node_t *ll2_merge_runs(ll2_node_t *a, ll2_node_t *b) {
+    ll2_node_t start;
+    ll2_node_t *last = &start;
 
-        /* This might be the only node */
-        if (*head == NULL) {
-            temp_node->next = NULL;
+    while (a != NULL && b != NULL) {
+        if (b->data < a->data) {
+            last->next = b;
+            b = b->next;
         } else {
-            (*head)->prev = temp_node;
-            temp_node->next = *head;
+            last->next = a;
+            a = a->next;
         }
-        temp_node->data = data;
-        *head = temp_node;
-        return LL2_SUCCESS;
+        last = last->next;
     }
+    last->next = (a != NULL) ? a : b;
 
-    temp_node = *head;
+    return start.next;
+}
 
-    /* Iterate through list */
-    while(temp < index-1) {
-        /* Make sure it is a valid index */
-        if (temp_node->next == NULL) {
-            return LL2_INDEX;
+/**
+ * @brief Sorts a run chained by next only
+ *
+ * Each node is merged into a bin of runs the way a binary counter carries,
+ * so bin i holds a sorted run of 2^i nodes or nothing. Higher bins hold
+ * earlier nodes and go first in every merge to keep the sort stable.
+ *
+ * @param node The first node of the run
+ *
+ * @return The first node of the sorted run
+ */
+static ll2_node_t *ll2_sort_run(ll2_node_t *node) {
+    ll2_node_t *bins[LL2_SORT_BINS] = { NULL };
+
+    while (node != NULL) {
+        ll2_node_t *carry = node;
+        node = node->next;
+        carry->next = NULL;
+
+        size_t i = 0;
+        while (i < LL2_SORT_BINS - 1 && bins[i] != NULL) {
+            carry = ll2_merge_runs(bins[i], carry);
+            bins[i] = NULL;
+            i++;
         }
+        bins[i] = ll2_merge_runs(bins[i], carry);
+    }
 
-        /* Jump nodes */
-        temp_node = temp_node->next;
-        temp++;
+    ll2_node_t *sorted = NULL;
+    for (size_t i = 0; i < LL2_SORT_BINS; i++) {
+        sorted = ll2_merge_runs(bins[i], sorted);
+    }
+
+    return sorted;
+}
+
+/**
+ * @brief Sets the prev pointers of a run chained by next
+ *
+ * @param head The first node of the run, or NULL
+ *
+ * @return The last node of the run, or NULL if it is empty
+ */
+static ll2_node_t *ll2_relink(ll2_node_t *head) {
+    ll2_node_t *prev = NULL;
+
+    for (ll2_node_t *node = head; node != NULL; node = node->next) {
+        node->prev = prev;
+        prev = node;
+    }
+
+    return prev;
+}
+
+ll2_err_t ll2_destroy(ll2_node_t **head) {
+    if (head == NULL) {
+        return LL2_NULLPTR;
+    }
+
+    ll2_free_all(*head, NULL);
+    *head = NULL;
+
+    return LL2_SUCCESS;
+}
+
+ll2_err_t ll2_add_node(ll2_node_t **head, uint32_t data, uint16_t index) {
+    return ll2_add_node_pool(head, data, index, NULL);
+}
+
+ll2_err_t ll2_add_node_pool(ll2_node_t **head, uint32_t data, uint16_t index, ll2_pool_t *pool) {
+    if (head == NULL) {
+        return LL2_NULLPTR;
+    }
+
+    ll2_node_t *prev = NULL;
+
+    /* Find the node before the index, it must exist */
+    if (index > 0) {
+        prev = ll2_walk(*head, index - 1);
+        if (prev == NULL) {
+            return LL2_INDEX;
+        }
     }
 
     /* Insert new node */
-    ll2_node_t *insert = (ll2_node_t *) malloc(sizeof(ll2_node_t));
+    ll2_node_t *insert = ll2_node_alloc(pool);
     if (insert == NULL) {
         return LL2_MEM;
     }
-    insert->prev = temp_node;
-    insert->next = temp_node->next;
     insert->data = data;
-    if (temp_node->next != NULL) {
-        temp_node->next->prev = insert;
-    }
-    temp_node->next = insert;
+    ll2_link(head, prev, insert);
 
     return LL2_SUCCESS;
 }
 
 ll2_err_t ll2_remove_node(ll2_node_t **head, uint16_t index) {
+    return ll2_remove_node_pool(head, index, NULL);
+}
+
+ll2_err_t ll2_remove_node_pool(ll2_node_t **head, uint16_t index, ll2_pool_t *pool) {
     if (head == NULL) {
         return LL2_NULLPTR;
     }
 
-    /* Must have some data */
-    if (*head == NULL) {
+    /* Make sure it is a valid index */
+    ll2_node_t *temp_node = ll2_walk(*head, index);
+    if (temp_node == NULL) {
         return LL2_INDEX;
     }
 
-    uint16_t temp = 0;
-    ll2_node_t *temp_node = *head;
+    /* Remove node */
+    ll2_unlink(head, temp_node);
+    ll2_node_free(pool, temp_node);
 
-    /* Special case for index = 0 */
-    if (index == 0) {
-        if (temp_node->next == NULL) {
-            free(temp_node);
-            *head = NULL;
-        } else {
-            ll2_node_t *t = temp_node->next;
-            t->prev = NULL;
-            free(temp_node);
-            *head = t;            
-        }
+    return LL2_SUCCESS;
+}
 
-        return LL2_SUCCESS;
+ll2_err_t ll2_insert_array(ll2_node_t **head, const uint32_t *values, size_t count, uint16_t index) {
+    return ll2_insert_array_pool(head, values, count, index, NULL);
+}
+
+ll2_err_t ll2_insert_array_pool(ll2_node_t **head, const uint32_t *values, size_t count, uint16_t index,
+                                ll2_pool_t *pool) {
+    if (head == NULL || (values == NULL && count > 0)) {
+        return LL2_NULLPTR;
     }
 
-    /* Iterate through list */
-    while(temp < index) {
-        /* Jump nodes */
-        temp_node = temp_node->next;
-        temp++;
- 
-        /* Make sure it is a valid index */
-        if (temp_node == NULL) {
+    ll2_node_t *prev = NULL;
+
+    /* Find the node before the index once for the whole run */
+    if (index > 0) {
+        prev = ll2_walk(*head, index - 1);
+        if (prev == NULL) {
             return LL2_INDEX;
         }
-   }
+    }
 
-    /* Remove node */
-    ll2_node_t *t = temp_node->prev;
-    t->next = temp_node->next;
-    if (temp_node->next != NULL) {
-        temp_node->next->prev = t;
+    if (count == 0) {
+        return LL2_SUCCESS;
+    }
+
+    ll2_node_t *first;
+    ll2_node_t *last;
+    if (ll2_build_run(values, count, pool, &first, &last) != LL2_SUCCESS) {
+        return LL2_MEM;
     }
-    free(temp_node);
+    ll2_splice(head, prev, first, last);
 
     return LL2_SUCCESS;
 }
 
-ll2_err_t ll2_search(ll2_node_t **head, uint32_t data, uint16_t *index) {
+ll2_err_t ll2_remove_range(ll2_node_t **head, uint16_t start, size_t count) {
+    return ll2_remove_range_pool(head, start, count, NULL);
+}
+
+ll2_err_t ll2_remove_range_pool(ll2_node_t **head, uint16_t start, size_t count, ll2_pool_t *pool) {
     if (head == NULL) {
-        *index = -1;
         return LL2_NULLPTR;
-    } 
-    
-    if (*head == NULL) {
-        *index = -1;
-        return LL2_DATA;
     }
 
-    uint16_t temp = 0;
-    ll2_node_t *temp_node = *head;
-    
-    while(temp_node != NULL) {
-        if (temp_node->data == data) {
-            *index = temp;
-            return LL2_SUCCESS;
-        }
-        temp_node = temp_node->next;
-        temp++;
+    if (count == 0) {
+        return LL2_SUCCESS;
     }
 
-    *index = -1;
-    return LL2_DATA;
+    /* Both ends of the run must exist before anything is cut */
+    ll2_node_t *first = ll2_walk(*head, start);
+    ll2_node_t *last = ll2_walk(first, count - 1);
+    if (last == NULL) {
+        return LL2_INDEX;
+    }
+
+    ll2_cut(head, first, last);
+    ll2_free_all(first, pool);
+
+    return LL2_SUCCESS;
 }
 
-uint16_t ll2_size(ll2_node_t **head) {
+ll2_err_t ll2_sort(ll2_node_t **head) {
     if (head == NULL) {
-        return 0;
+        return LL2_NULLPTR;
     }
 
-    if (*head == 0) {
-        return 0;
-    }
+    *head = ll2_sort_run(*head);
+    ll2_relink(*head);
 
-    uint16_t ctr = 0;
-    ll2_node_t *temp_node = *head;
-    
-    while(temp_node != NULL) {
-        temp_node = temp_node->next;
-        ctr++;
-    }
+    return LL2_SUCCESS;
+}
 
-    return ctr;
+ll2_err_t ll2_add_sorted(ll2_node_t **head, uint32_t data) {
+    return ll2_add_sorted_pool(head, data, NULL);
 }
 
+ll2_err_t ll2_add_sorted_pool(ll2_node_t **head, uint32_t data, ll2_pool_t *pool) {
+    if (head == NULL) {
+        return LL2_NULLPTR;
+    }
+
+    /* Go past every node that is not greater */
+    ll2_node_t *prev = NULL;
+    for (ll2_node_t *node = *head; node != NULL && node->data <= data; node = node->next) {
+        prev = node;
+    }
 
+    ll2_node_t *insert = ll2_node_alloc(pool);
+    if (insert == NULL) {
+        return LL2_MEM;
+    }
+    insert->data = data;
+    ll2_link(head, prev, insert);
 
+    return LL2_SUCCESS;
+}
+
+ll2_err_t ll2_merge(ll2_node_t **dst, ll2_node_t **src) {
+    if (dst == NULL || src == NULL) {
+        return LL2_NULLPTR;
+    }
+
+    *dst = ll2_merge_runs(*dst, *src);
+    *src = NULL;
+    ll2_relink(*dst);
+
+    return LL2_SUCCESS;
+}
+
+ll2_err_t ll2_search(ll2_node_t **head, uint32_t data, uint16_t *index) {
+    if (head == NULL) {
+        *index = -1;
+        return LL2_NULLPTR;
+    } 
+
+    size_t temp;
+    if (ll2_find(*head, data, &temp) != LL2_SUCCESS) {
+        *index = -1;
+        return LL2_DATA;
+    }
+
+    *index = (uint16_t) temp;
+    return LL2_SUCCESS;
+}
+
+uint16_t ll2_size(ll2_node_t **head) {
+    if (head == NULL) {
+        return 0;
+    }
+
+    uint16_t ctr = 0;
+    ll2_node_t *temp_node = *head;
+    
+    while(temp_node != NULL) {
+        temp_node = temp_node->next;
+        ctr++;
+    }
+
+    return ctr;
+}
+
+/**
+ * @brief Adds a new node to a list handle after another node
+ *
+ * Keeps the tail, count and value index of the handle up to date.
+ *
+ * @param list The list to add to
+ * @param prev The node to insert after, or NULL to insert at the head
+ * @param data The data for the new node
+ * @param index The index the new node ends up at
+ *
+ * @return The new node, or NULL if out of memory
+ */
+static ll2_node_t *ll2_list_link_new(ll2_list_t *list, ll2_node_t *prev, uint32_t data, size_t index) {
+    /* Make room in the lookup first so nothing has to be undone */
+    if (list->lookup != NULL && ll2_index_reserve(list->lookup, list->count + 1) != LL2_SUCCESS) {
+        return NULL;
+    }
+
+    ll2_node_t *insert = ll2_node_alloc(list->pool);
+    if (insert == NULL) {
+        return NULL;
+    }
+    insert->data = data;
+
+    /* Only an append leaves the other positions as they were */
+    if (list->lookup != NULL) {
+        if (ll2_index_insert(list->lookup, insert, index) != LL2_SUCCESS) {
+            ll2_node_free(list->pool, insert);
+            return NULL;
+        }
+        if (index != list->count) {
+            list->lookup->stale = 1;
+        }
+    }
+
+    ll2_link(&list->head, prev, insert);
+    if (insert->next == NULL) {
+        list->tail = insert;
+    }
+    list->count++;
+
+    return insert;
+}
+
+/**
+ * @brief Removes a node from a list handle and releases it
+ *
+ * Keeps the tail, count and value index of the handle up to date.
+ *
+ * @param list The list to remove from
+ * @param node The node to remove
+ */
+static void ll2_list_drop(ll2_list_t *list, ll2_node_t *node) {
+    if (node == list->tail) {
+        list->tail = node->prev;
+    } else if (list->lookup != NULL) {
+        list->lookup->stale = 1;
+    }
+    if (list->lookup != NULL) {
+        ll2_index_erase(list->lookup, node);
+    }
+    ll2_unlink(&list->head, node);
+    ll2_node_free(list->pool, node);
+    list->count--;
+}
+
+ll2_err_t ll2_list_init(ll2_list_t *list, ll2_pool_t *pool) {
+    if (list == NULL) {
+        return LL2_NULLPTR;
+    }
+
+    list->head = NULL;
+    list->tail = NULL;
+    list->count = 0;
+    list->pool = pool;
+    list->lookup = NULL;
+
+    return LL2_SUCCESS;
+}
+
+ll2_err_t ll2_list_destroy(ll2_list_t *list) {
+    if (list == NULL) {
+        return LL2_NULLPTR;
+    }
+
+    /* A pooled list goes in one step */
+    if (list->pool != NULL) {
+        ll2_destroy_pool(&list->head, list->pool);
+    } else {
+        ll2_free_all(list->head, NULL);
+    }
+
+    list->head = NULL;
+    list->tail = NULL;
+    list->count = 0;
+    if (list->lookup != NULL) {
+        ll2_index_clear(list->lookup);
+    }
+
+    return LL2_SUCCESS;
+}
+
+ll2_err_t ll2_list_add(ll2_list_t *list, uint32_t data, size_t index) {
+    if (list == NULL) {
+        return LL2_NULLPTR;
+    }
+
+    if (index > list->count) {
+        return LL2_INDEX;
+    }
+
+    ll2_node_t *prev = (index == 0) ? NULL : ll2_list_node(list, index - 1);
+    return ll2_list_link_new(list, prev, data, index) != NULL ? LL2_SUCCESS : LL2_MEM;
+}
+
+ll2_err_t ll2_list_remove(ll2_list_t *list, size_t index) {
+    if (list == NULL) {
+        return LL2_NULLPTR;
+    }
+
+    if (index >= list->count) {
+        return LL2_INDEX;
+    }
+
+    ll2_list_drop(list, ll2_list_node(list, index));
+
+    return LL2_SUCCESS;
+}
+
+ll2_err_t ll2_list_insert_array(ll2_list_t *list, const uint32_t *values, size_t count, size_t index) {
+    if (list == NULL || (values == NULL && count > 0)) {
+        return LL2_NULLPTR;
+    }
+
+    if (index > list->count) {
+        return LL2_INDEX;
+    }
+
+    if (count == 0) {
+        return LL2_SUCCESS;
+    }
+
+    if (list->lookup != NULL && ll2_index_reserve(list->lookup, list->count + count) != LL2_SUCCESS) {
+        return LL2_MEM;
+    }
+
+    ll2_node_t *first;
+    ll2_node_t *last;
+    if (ll2_build_run(values, count, list->pool, &first, &last) != LL2_SUCCESS) {
+        return LL2_MEM;
+    }
+
+    /* Index the run while it is still on its own so a failure can be undone */
+    if (list->lookup != NULL) {
+        size_t pos = index;
+        for (ll2_node_t *node = first; node != NULL; node = node->next) {
+            if (ll2_index_insert(list->lookup, node, pos++) != LL2_SUCCESS) {
+                for (ll2_node_t *done = first; done != node; done = done->next) {
+                    ll2_index_erase(list->lookup, done);
+                }
+                ll2_free_all(first, list->pool);
+                return LL2_MEM;
+            }
+        }
+        if (index != list->count) {
+            list->lookup->stale = 1;
+        }
+    }
+
+    ll2_node_t *prev = (index == 0) ? NULL : ll2_list_node(list, index - 1);
+    ll2_splice(&list->head, prev, first, last);
+    if (last->next == NULL) {
+        list->tail = last;
+    }
+    list->count += count;
+
+    return LL2_SUCCESS;
+}
+
+ll2_err_t ll2_list_remove_range(ll2_list_t *list, size_t start, size_t count) {
+    if (list == NULL) {
+        return LL2_NULLPTR;
+    }
+
+    if (start > list->count || count > list->count - start) {
+        return LL2_INDEX;
+    }
+
+    if (count == 0) {
+        return LL2_SUCCESS;
+    }
+
+    ll2_node_t *first = ll2_list_node(list, start);
+    ll2_node_t *last = ll2_walk(first, count - 1);
+    if (last == list->tail) {
+        list->tail = first->prev;
+    } else if (list->lookup != NULL) {
+        list->lookup->stale = 1;
+    }
+    if (list->lookup != NULL) {
+        for (ll2_node_t *node = first; node != last->next; node = node->next) {
+            ll2_index_erase(list->lookup, node);
+        }
+    }
+    ll2_cut(&list->head, first, last);
+    ll2_free_all(first, list->pool);
+    list->count -= count;
+
+    return LL2_SUCCESS;
+}
+
+ll2_err_t ll2_list_sort(ll2_list_t *list) {
+    if (list == NULL) {
+        return LL2_NULLPTR;
+    }
+
+    list->head = ll2_sort_run(list->head);
+    list->tail = ll2_relink(list->head);
+    if (list->lookup != NULL) {
+        list->lookup->stale = 1;
+    }
+
+    return LL2_SUCCESS;
+}
+
+ll2_err_t ll2_list_add_sorted(ll2_list_t *list, uint32_t data) {
+    if (list == NULL) {
+        return LL2_NULLPTR;
+    }
+
+    /* Step back over every node that is greater */
+    ll2_node_t *prev = list->tail;
+    size_t index = list->count;
+    while (prev != NULL && prev->data > data) {
+        prev = prev->prev;
+        index--;
+    }
+
+    return ll2_list_link_new(list, prev, data, index) != NULL ? LL2_SUCCESS : LL2_MEM;
+}
+
+ll2_err_t ll2_list_merge(ll2_list_t *dst, ll2_list_t *src) {
+    if (dst == NULL || src == NULL) {
+        return LL2_NULLPTR;
+    }
+
+    if (dst->pool != NULL || src->pool != NULL) {
+        return LL2_OTHER;
+    }
+
+    if (dst == src || src->count == 0) {
+        return LL2_SUCCESS;
+    }
+
+    /* Move the src nodes over to the dst lookup before relinking */
+    if (dst->lookup != NULL) {
+        if (ll2_index_reserve(dst->lookup, dst->count + src->count) != LL2_SUCCESS) {
+            return LL2_MEM;
+        }
+        for (ll2_node_t *node = src->head; node != NULL; node = node->next) {
+            if (ll2_index_insert(dst->lookup, node, 0) != LL2_SUCCESS) {
+                for (ll2_node_t *done = src->head; done != node; done = done->next) {
+                    ll2_index_erase(dst->lookup, done);
+                }
+                return LL2_MEM;
+            }
+        }
+        dst->lookup->stale = 1;
+    }
+    if (src->lookup != NULL) {
+        ll2_index_clear(src->lookup);
+    }
+
+    dst->head = ll2_merge_runs(dst->head, src->head);
+    dst->tail = ll2_relink(dst->head);
+    dst->count += src->count;
+
+    src->head = NULL;
+    src->tail = NULL;
+    src->count = 0;
+
+    return LL2_SUCCESS;
+}
+
+ll2_err_t ll2_list_push_back(ll2_list_t *list, uint32_t data) {
+    if (list == NULL) {
+        return LL2_NULLPTR;
+    }
+
+    return ll2_list_add(list, data, list->count);
+}
+
+ll2_err_t ll2_list_pop_back(ll2_list_t *list, uint32_t *data) {
+    if (list == NULL || data == NULL) {
+        return LL2_NULLPTR;
+    }
+
+    if (list->count == 0) {
+        return LL2_INDEX;
+    }
+
+    *data = list->tail->data;
+    return ll2_list_remove(list, list->count - 1);
+}
+
+ll2_err_t ll2_list_search(ll2_list_t *list, uint32_t data, size_t *index) {
+    if (list == NULL || index == NULL) {
+        return LL2_NULLPTR;
+    }
+
+    if (list->lookup != NULL) {
+        return ll2_index_position(list->lookup, list->head, data, index);
+    }
+
+    return ll2_find(list->head, data, index);
+}
+
+size_t ll2_list_size(ll2_list_t *list) {
+    if (list == NULL) {
+        return 0;
+    }
+
+    return list->count;
+}
+
+ll2_err_t ll2_list_index_enable(ll2_list_t *list) {
+    if (list == NULL) {
+        return LL2_NULLPTR;
+    }
+
+    if (list->lookup != NULL) {
+        return LL2_SUCCESS;
+    }
+
+    ll2_index_t *lookup;
+    if (ll2_index_create(&lookup) != LL2_SUCCESS) {
+        return LL2_MEM;
+    }
+    if (ll2_index_reserve(lookup, list->count) != LL2_SUCCESS) {
+        ll2_index_destroy(lookup);
+        return LL2_MEM;
+    }
+
+    size_t pos = 0;
+    for (ll2_node_t *node = list->head; node != NULL; node = node->next) {
+        if (ll2_index_insert(lookup, node, pos++) != LL2_SUCCESS) {
+            ll2_index_destroy(lookup);
+            return LL2_MEM;
+        }
+    }
+    list->lookup = lookup;
+
+    return LL2_SUCCESS;
+}
+
+ll2_err_t ll2_list_index_disable(ll2_list_t *list) {
+    if (list == NULL) {
+        return LL2_NULLPTR;
+    }
+
+    if (list->lookup != NULL) {
+        ll2_index_destroy(list->lookup);
+        list->lookup = NULL;
+    }
+
+    return LL2_SUCCESS;
+}
+
+ll2_err_t ll2_list_locate(ll2_list_t *list, uint32_t data, ll2_node_t **node) {
+    if (list == NULL || node == NULL) {
+        return LL2_NULLPTR;
+    }
+
+    if (list->lookup != NULL) {
+        *node = ll2_index_find(list->lookup, data);
+    } else {
+        *node = list->head;
+        while (*node != NULL && (*node)->data != data) {
+            *node = (*node)->next;
+        }
+    }
+
+    return (*node != NULL) ? LL2_SUCCESS : LL2_DATA;
+}
+
+ll2_err_t ll2_cursor_init(ll2_cursor_t *cursor, ll2_node_t **head, ll2_pool_t *pool) {
+    if (cursor == NULL || head == NULL) {
+        return LL2_NULLPTR;
+    }
+
+    cursor->head = head;
+    cursor->list = NULL;
+    cursor->pool = pool;
+    cursor->prev = NULL;
+    cursor->index = 0;
+
+    return LL2_SUCCESS;
+}
+
+ll2_err_t ll2_list_cursor_init(ll2_cursor_t *cursor, ll2_list_t *list, size_t index) {
+    if (cursor == NULL || list == NULL) {
+        return LL2_NULLPTR;
+    }
+
+    if (index > list->count) {
+        return LL2_INDEX;
+    }
+
+    cursor->head = &list->head;
+    cursor->list = list;
+    cursor->pool = list->pool;
+    cursor->prev = (index == 0) ? NULL : ll2_list_node(list, index - 1);
+    cursor->index = index;
+
+    return LL2_SUCCESS;
+}
+
+/**
+ * @brief Returns the node a cursor is at
+ *
+ * @param cursor The cursor
+ *
+ * @return The node after prev, or NULL at the end
+ */
+static ll2_node_t *ll2_cursor_node(ll2_cursor_t *cursor) {
+    return (cursor->prev == NULL) ? *cursor->head : cursor->prev->next;
+}
+
+ll2_err_t ll2_cursor_next(ll2_cursor_t *cursor) {
+    if (cursor == NULL) {
+        return LL2_NULLPTR;
+    }
+
+    ll2_node_t *node = ll2_cursor_node(cursor);
+    if (node == NULL) {
+        return LL2_INDEX;
+    }
+
+    cursor->prev = node;
+    cursor->index++;
+
+    return LL2_SUCCESS;
+}
+
+ll2_err_t ll2_cursor_prev(ll2_cursor_t *cursor) {
+    if (cursor == NULL) {
+        return LL2_NULLPTR;
+    }
+
+    if (cursor->prev == NULL) {
+        return LL2_INDEX;
+    }
+
+    cursor->prev = cursor->prev->prev;
+    cursor->index--;
+
+    return LL2_SUCCESS;
+}
+
+ll2_err_t ll2_cursor_get(ll2_cursor_t *cursor, uint32_t *data) {
+    if (cursor == NULL || data == NULL) {
+        return LL2_NULLPTR;
+    }
+
+    ll2_node_t *node = ll2_cursor_node(cursor);
+    if (node == NULL) {
+        return LL2_INDEX;
+    }
+
+    *data = node->data;
+    return LL2_SUCCESS;
+}
+
+size_t ll2_cursor_index(ll2_cursor_t *cursor) {
+    if (cursor == NULL) {
+        return 0;
+    }
+
+    return cursor->index;
+}
+
+/**
+ * @brief Adds a new node after another one for a cursor
+ *
+ * @param cursor The cursor whose list to add to
+ * @param prev The node to insert after, or NULL to insert at the head
+ * @param data The data for the new node
+ * @param index The index the new node ends up at
+ *
+ * @return The new node, or NULL if out of memory
+ */
+static ll2_node_t *ll2_cursor_link_new(ll2_cursor_t *cursor, ll2_node_t *prev, uint32_t data, size_t index) {
+    if (cursor->list != NULL) {
+        return ll2_list_link_new(cursor->list, prev, data, index);
+    }
+
+    ll2_node_t *insert = ll2_node_alloc(cursor->pool);
+    if (insert == NULL) {
+        return NULL;
+    }
+    insert->data = data;
+    ll2_link(cursor->head, prev, insert);
+
+    return insert;
+}
+
+ll2_err_t ll2_cursor_insert_before(ll2_cursor_t *cursor, uint32_t data) {
+    if (cursor == NULL) {
+        return LL2_NULLPTR;
+    }
+
+    ll2_node_t *insert = ll2_cursor_link_new(cursor, cursor->prev, data, cursor->index);
+    if (insert == NULL) {
+        return LL2_MEM;
+    }
+
+    /* Stay on the same node, which now has one more before it */
+    cursor->prev = insert;
+    cursor->index++;
+
+    return LL2_SUCCESS;
+}
+
+ll2_err_t ll2_cursor_insert_after(ll2_cursor_t *cursor, uint32_t data) {
+    if (cursor == NULL) {
+        return LL2_NULLPTR;
+    }
+
+    ll2_node_t *node = ll2_cursor_node(cursor);
+    if (node == NULL) {
+        return LL2_INDEX;
+    }
+
+    if (ll2_cursor_link_new(cursor, node, data, cursor->index + 1) == NULL) {
+        return LL2_MEM;
+    }
+
+    return LL2_SUCCESS;
+}
+
+ll2_err_t ll2_cursor_remove(ll2_cursor_t *cursor) {
+    if (cursor == NULL) {
+        return LL2_NULLPTR;
+    }
+
+    ll2_node_t *node = ll2_cursor_node(cursor);
+    if (node == NULL) {
+        return LL2_INDEX;
+    }
+
+    if (cursor->list != NULL) {
+        ll2_list_drop(cursor->list, node);
+    } else {
+        ll2_unlink(cursor->head, node);
+        ll2_node_free(cursor->pool, node);
+    }
+
+    return LL2_SUCCESS;
+}
@@ -0,0 +1,279 @@
+/******************************************************************************
+* Copyright (C) 2017 by Ben Heberlein
+*
+* Redistribution, modification or use of this software in source or binary
+* forms is permitted as long as the files maintain this copyright. This file
+* was created for the University of Colorado Boulder course Advanced Practical
+* Embedded Software Development. Ben Heberlein and the University of Colorado
+* are not liable for any misuse of this material.
+*
+*******************************************************************************/
+/**
+ * @file ll2_index.c
+ * @brief The implementation for the ll2 value index
+ *
+ * This file provides a linear probing hash table from data values to list
+ * nodes, with one entry per distinct value, backward shift removal and
+ * lazily renumbered positions.
+ *
+ * @author Ben Heberlein
+ * @date October 17 2026
+ * @version 1.0
+ *
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "ll2_index.h"
+
+#define LL2_INDEX_MIN_SLOTS 16
+#define LL2_INDEX_MIN_MORE 4
+
+/**
+ * @brief Spreads the bits of a value over the whole word
+ *
+ * @param key The value to hash
+ *
+ * @return The hash of key
+ */
+static inline size_t ll2_index_hash(uint32_t key) {
+    uint64_t h = key;
+    h ^= h >> 16;
+    h *= 0x9e3779b97f4a7c15ULL;
+    h ^= h >> 32;
+    return (size_t) h;
+}
+
+/**
+ * @brief Places an entry in a table known to have room
+ *
+ * @param slots The table
+ * @param mask The table size minus one
+ * @param entry The entry to place
+ */
+static void ll2_index_place(ll2_index_entry_t *slots, size_t mask, const ll2_index_entry_t *entry) {
+    size_t i = ll2_index_hash(entry->key) & mask;
+
+    while (slots[i].node != NULL) {
+        i = (i + 1) & mask;
+    }
+    slots[i] = *entry;
+}
+
+/**
+ * @brief Finds the entry of a value
+ *
+ * @param index The index to look in
+ * @param key The value to find
+ *
+ * @return The entry, or NULL if no node holds key
+ */
+static ll2_index_entry_t *ll2_index_entry(ll2_index_t *index, uint32_t key) {
+    size_t i = ll2_index_hash(key) & index->mask;
+
+    while (index->slots[i].node != NULL) {
+        if (index->slots[i].key == key) {
+            return &index->slots[i];
+        }
+        i = (i + 1) & index->mask;
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Empties a slot, pulling later entries of its run back
+ *
+ * @param index The index to remove from
+ * @param hole The slot to empty
+ */
+static void ll2_index_shift(ll2_index_t *index, size_t hole) {
+    size_t i = hole;
+
+    /* Pull later entries of the run back so no probe sequence is broken */
+    for (;;) {
+        i = (i + 1) & index->mask;
+        if (index->slots[i].node == NULL) {
+            break;
+        }
+
+        /* An entry may only move back if its home slot is not between hole and i */
+        size_t home = ll2_index_hash(index->slots[i].key) & index->mask;
+        if (((i - home) & index->mask) >= ((i - hole) & index->mask)) {
+            index->slots[hole] = index->slots[i];
+            hole = i;
+        }
+    }
+
+    index->slots[hole].node = NULL;
+    index->slots[hole].more = NULL;
+    index->slots[hole].extra = 0;
+    index->slots[hole].room = 0;
+}
+
+/**
+ * @brief Frees the duplicate arrays of every entry
+ *
+ * @param index The index to release them from
+ */
+static void ll2_index_free_more(ll2_index_t *index) {
+    for (size_t i = 0; i <= index->mask; i++) {
+        free(index->slots[i].more);
+    }
+}
+
+ll2_err_t ll2_index_create(ll2_index_t **index) {
+    if (index == NULL) {
+        return LL2_NULLPTR;
+    }
+
+    *index = (ll2_index_t *) malloc(sizeof(ll2_index_t));
+    if (*index == NULL) {
+        return LL2_MEM;
+    }
+
+    (*index)->slots = (ll2_index_entry_t *) calloc(LL2_INDEX_MIN_SLOTS, sizeof(ll2_index_entry_t));
+    if ((*index)->slots == NULL) {
+        free(*index);
+        *index = NULL;
+        return LL2_MEM;
+    }
+    (*index)->mask = LL2_INDEX_MIN_SLOTS - 1;
+    (*index)->used = 0;
+    (*index)->stale = 0;
+
+    return LL2_SUCCESS;
+}
+
+ll2_err_t ll2_index_destroy(ll2_index_t *index) {
+    if (index == NULL) {
+        return LL2_NULLPTR;
+    }
+
+    ll2_index_free_more(index);
+    free(index->slots);
+    free(index);
+    return LL2_SUCCESS;
+}
+
+void ll2_index_clear(ll2_index_t *index) {
+    ll2_index_free_more(index);
+    memset(index->slots, 0, (index->mask + 1) * sizeof(ll2_index_entry_t));
+    index->used = 0;
+    index->stale = 0;
+}
+
+ll2_err_t ll2_index_reserve(ll2_index_t *index, size_t count) {
+    size_t slots = index->mask + 1;
+
+    /* Keep the load factor at or below 0.7 */
+    if (count * 10 <= slots * 7) {
+        return LL2_SUCCESS;
+    }
+    while (count * 10 > slots * 7) {
+        slots *= 2;
+    }
+
+    ll2_index_entry_t *grown = (ll2_index_entry_t *) calloc(slots, sizeof(ll2_index_entry_t));
+    if (grown == NULL) {
+        return LL2_MEM;
+    }
+
+    for (size_t i = 0; i <= index->mask; i++) {
+        if (index->slots[i].node != NULL) {
+            ll2_index_place(grown, slots - 1, &index->slots[i]);
+        }
+    }
+
+    free(index->slots);
+    index->slots = grown;
+    index->mask = slots - 1;
+
+    return LL2_SUCCESS;
+}
+
+ll2_err_t ll2_index_insert(ll2_index_t *index, ll2_node_t *node, size_t pos) {
+    ll2_index_entry_t *entry = ll2_index_entry(index, node->data);
+
+    if (entry == NULL) {
+        ll2_index_entry_t fresh = { node, NULL, 0, 0, pos, node->data };
+        ll2_index_place(index->slots, index->mask, &fresh);
+        index->used++;
+        return LL2_SUCCESS;
+    }
+
+    /* Another node with this value, it goes on the entry's array */
+    if (entry->extra == entry->room) {
+        size_t room = (entry->room == 0) ? LL2_INDEX_MIN_MORE : 2 * entry->room;
+        ll2_node_t **more = (ll2_node_t **) realloc(entry->more, room * sizeof(ll2_node_t *));
+        if (more == NULL) {
+            return LL2_MEM;
+        }
+        entry->more = more;
+        entry->room = room;
+    }
+    entry->more[entry->extra++] = node;
+    if (pos < entry->pos) {
+        entry->pos = pos;
+    }
+
+    return LL2_SUCCESS;
+}
+
+void ll2_index_erase(ll2_index_t *index, ll2_node_t *node) {
+    ll2_index_entry_t *entry = ll2_index_entry(index, node->data);
+
+    /* The last node with this value takes the whole entry with it */
+    if (entry->extra == 0) {
+        free(entry->more);
+        ll2_index_shift(index, (size_t) (entry - index->slots));
+        index->used--;
+        return;
+    }
+
+    /* Otherwise the last duplicate fills the gap */
+    if (entry->node == node) {
+        entry->node = entry->more[--entry->extra];
+    } else {
+        size_t i = 0;
+        while (entry->more[i] != node) {
+            i++;
+        }
+        entry->more[i] = entry->more[--entry->extra];
+    }
+}
+
+ll2_node_t *ll2_index_find(ll2_index_t *index, uint32_t data) {
+    ll2_index_entry_t *entry = ll2_index_entry(index, data);
+
+    return (entry != NULL) ? entry->node : NULL;
+}
+
+ll2_err_t ll2_index_position(ll2_index_t *index, ll2_node_t *head, uint32_t data, size_t *pos) {
+    ll2_index_entry_t *entry = ll2_index_entry(index, data);
+
+    /* Check membership before paying for a renumber */
+    if (entry == NULL) {
+        return LL2_DATA;
+    }
+
+    /* Every entry keeps the position of the first of its nodes */
+    if (index->stale) {
+        for (size_t i = 0; i <= index->mask; i++) {
+            index->slots[i].pos = SIZE_MAX;
+        }
+        size_t p = 0;
+        for (ll2_node_t *node = head; node != NULL; node = node->next) {
+            ll2_index_entry_t *first = ll2_index_entry(index, node->data);
+            if (first->pos == SIZE_MAX) {
+                first->pos = p;
+            }
+            p++;
+        }
+        index->stale = 0;
+    }
+
+    *pos = entry->pos;
+    return LL2_SUCCESS;
+}
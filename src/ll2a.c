@@ -0,0 +1,259 @@
+/******************************************************************************
+* Copyright (C) 2017 by Ben Heberlein
+*
+* Redistribution, modification or use of this software in source or binary
+* forms is permitted as long as the files maintain this copyright. This file
+* was created for the University of Colorado Boulder course Advanced Practical
+* Embedded Software Development. Ben Heberlein and the University of Colorado
+* are not liable for any misuse of this material.
+*
+*******************************************************************************/
+/**
+ * @file ll2a.c
+ * @brief The implementation for a compact array backed doubly linked list
+ *
+ * This file provides the function implementations for a doubly linked list
+ * stored in one array of 12 byte nodes linked by slot number.
+ *
+ * @author Ben Heberlein
+ * @date October 17 2026
+ * @version 1.0
+ *
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "ll2a.h"
+
+#define LL2A_MIN_CAPACITY 16
+
+/**
+ * @brief Takes a slot from the free list, or a fresh one, growing the array
+ *
+ * @param list The list to take from
+ *
+ * @return The slot number, or LL2A_NIL if out of memory
+ */
+static uint32_t ll2a_slot_alloc(ll2a_list_t *list) {
+    if (list->free != LL2A_NIL) {
+        uint32_t slot = list->free;
+        list->free = list->nodes[slot].next;
+        return slot;
+    }
+
+    if (list->used == list->capacity) {
+        /* LL2A_NIL is never a slot number */
+        if (list->capacity == LL2A_NIL - 1) {
+            return LL2A_NIL;
+        }
+
+        uint64_t grown = (list->capacity < LL2A_MIN_CAPACITY) ? LL2A_MIN_CAPACITY : 2 * (uint64_t) list->capacity;
+        if (grown > LL2A_NIL - 1) {
+            grown = LL2A_NIL - 1;
+        }
+
+        ll2a_node_t *nodes = (ll2a_node_t *) realloc(list->nodes, grown * sizeof(ll2a_node_t));
+        if (nodes == NULL) {
+            return LL2A_NIL;
+        }
+        list->nodes = nodes;
+        list->capacity = (uint32_t) grown;
+    }
+
+    return list->used++;
+}
+
+/**
+ * @brief Finds the slot at an index, walking from the closer end
+ *
+ * @param list The list to walk, index must be below list->count
+ * @param index The index of the node
+ *
+ * @return The slot number of the node at index
+ */
+static uint32_t ll2a_slot_at(ll2a_list_t *list, size_t index) {
+    uint32_t slot;
+
+    if (index < list->count / 2) {
+        slot = list->head;
+        while (index-- > 0) {
+            slot = list->nodes[slot].next;
+        }
+    } else {
+        slot = list->tail;
+        for (size_t steps = list->count - 1 - index; steps > 0; steps--) {
+            slot = list->nodes[slot].prev;
+        }
+    }
+
+    return slot;
+}
+
+ll2_err_t ll2a_init(ll2a_list_t *list, size_t capacity) {
+    if (list == NULL) {
+        return LL2_NULLPTR;
+    }
+
+    if (capacity > LL2A_NIL - 1) {
+        return LL2_MEM;
+    }
+
+    list->nodes = NULL;
+    if (capacity > 0) {
+        list->nodes = (ll2a_node_t *) malloc(capacity * sizeof(ll2a_node_t));
+        if (list->nodes == NULL) {
+            return LL2_MEM;
+        }
+    }
+    list->capacity = (uint32_t) capacity;
+    list->used = 0;
+    list->free = LL2A_NIL;
+    list->head = LL2A_NIL;
+    list->tail = LL2A_NIL;
+    list->count = 0;
+
+    return LL2_SUCCESS;
+}
+
+ll2_err_t ll2a_destroy(ll2a_list_t *list) {
+    if (list == NULL) {
+        return LL2_NULLPTR;
+    }
+
+    free(list->nodes);
+    return ll2a_init(list, 0);
+}
+
+ll2_err_t ll2a_add(ll2a_list_t *list, uint32_t data, size_t index) {
+    if (list == NULL) {
+        return LL2_NULLPTR;
+    }
+
+    if (index > list->count) {
+        return LL2_INDEX;
+    }
+
+    uint32_t slot = ll2a_slot_alloc(list);
+    if (slot == LL2A_NIL) {
+        return LL2_MEM;
+    }
+
+    /* Link between prev and the node now at index */
+    uint32_t next = (index == list->count) ? LL2A_NIL : ll2a_slot_at(list, index);
+    uint32_t prev = (next == LL2A_NIL) ? list->tail : list->nodes[next].prev;
+    ll2a_node_t *node = &list->nodes[slot];
+
+    node->data = data;
+    node->prev = prev;
+    node->next = next;
+    if (prev == LL2A_NIL) {
+        list->head = slot;
+    } else {
+        list->nodes[prev].next = slot;
+    }
+    if (next == LL2A_NIL) {
+        list->tail = slot;
+    } else {
+        list->nodes[next].prev = slot;
+    }
+    list->count++;
+
+    return LL2_SUCCESS;
+}
+
+ll2_err_t ll2a_push_back(ll2a_list_t *list, uint32_t data) {
+    if (list == NULL) {
+        return LL2_NULLPTR;
+    }
+
+    return ll2a_add(list, data, list->count);
+}
+
+ll2_err_t ll2a_remove(ll2a_list_t *list, size_t index) {
+    if (list == NULL) {
+        return LL2_NULLPTR;
+    }
+
+    if (index >= list->count) {
+        return LL2_INDEX;
+    }
+
+    uint32_t slot = ll2a_slot_at(list, index);
+    ll2a_node_t *node = &list->nodes[slot];
+
+    if (node->prev == LL2A_NIL) {
+        list->head = node->next;
+    } else {
+        list->nodes[node->prev].next = node->next;
+    }
+    if (node->next == LL2A_NIL) {
+        list->tail = node->prev;
+    } else {
+        list->nodes[node->next].prev = node->prev;
+    }
+
+    node->next = list->free;
+    list->free = slot;
+    list->count--;
+
+    return LL2_SUCCESS;
+}
+
+ll2_err_t ll2a_get(ll2a_list_t *list, size_t index, uint32_t *data) {
+    if (list == NULL || data == NULL) {
+        return LL2_NULLPTR;
+    }
+
+    if (index >= list->count) {
+        return LL2_INDEX;
+    }
+
+    *data = list->nodes[ll2a_slot_at(list, index)].data;
+    return LL2_SUCCESS;
+}
+
+ll2_err_t ll2a_search(ll2a_list_t *list, uint32_t data, size_t *index) {
+    if (list == NULL || index == NULL) {
+        return LL2_NULLPTR;
+    }
+
+    size_t temp = 0;
+    for (uint32_t slot = list->head; slot != LL2A_NIL; slot = list->nodes[slot].next) {
+        if (list->nodes[slot].data == data) {
+            *index = temp;
+            return LL2_SUCCESS;
+        }
+        temp++;
+    }
+
+    return LL2_DATA;
+}
+
+size_t ll2a_size(ll2a_list_t *list) {
+    if (list == NULL) {
+        return 0;
+    }
+
+    return list->count;
+}
+
+ll2_err_t ll2a_copy(ll2a_list_t *dst, const ll2a_list_t *src) {
+    if (dst == NULL || src == NULL) {
+        return LL2_NULLPTR;
+    }
+
+    *dst = *src;
+    dst->nodes = NULL;
+    dst->capacity = src->used;
+    if (src->used > 0) {
+        dst->nodes = (ll2a_node_t *) malloc(src->used * sizeof(ll2a_node_t));
+        if (dst->nodes == NULL) {
+            ll2a_init(dst, 0);
+            return LL2_MEM;
+        }
+        memcpy(dst->nodes, src->nodes, src->used * sizeof(ll2a_node_t));
+    }
+
+    return LL2_SUCCESS;
+}
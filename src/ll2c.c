@@ -0,0 +1,386 @@
+/******************************************************************************
+* Copyright (C) 2017 by Ben Heberlein
+*
+* Redistribution, modification or use of this software in source or binary
+* forms is permitted as long as the files maintain this copyright. This file
+* was created for the University of Colorado Boulder course Advanced Practical
+* Embedded Software Development. Ben Heberlein and the University of Colorado
+* are not liable for any misuse of this material.
+*
+*******************************************************************************/
+/**
+ * @file ll2c.c
+ * @brief The implementation for a lock-free concurrent list
+ *
+ * This file provides the function implementations for a Harris style list
+ * with epoch based reclamation. Updates walk with ll2c_locate, which unlinks
+ * any marked node it passes. Whoever unlinks a node retires it, so a node is
+ * retired exactly once.
+ *
+ * @author Ben Heberlein
+ * @date October 17 2026
+ * @version 1.0
+ *
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdatomic.h>
+#include "ll2c.h"
+
+/* Retirements between attempts to move the global epoch on */
+#define LL2C_RETIRE_BATCH 32
+
+#define LL2C_MARK ((uintptr_t) 1)
+#define LL2C_PTR(link) ((ll2c_node_t *) ((link) & ~LL2C_MARK))
+
+/**
+ * @brief Frees a chain of retired nodes
+ *
+ * @param node The first node of the chain
+ */
+static void ll2c_free_chain(ll2c_node_t *node) {
+    while (node != NULL) {
+        ll2c_node_t *next = node->retired;
+        free(node);
+        node = next;
+    }
+}
+
+/**
+ * @brief Announces the thread in the current epoch and frees what it can
+ *
+ * @param list The list being entered
+ * @param thread The slot of the calling thread
+ */
+static void ll2c_enter(ll2c_list_t *list, ll2c_thread_t *thread) {
+    uint64_t epoch = atomic_load_explicit(&list->epoch, memory_order_seq_cst);
+
+    atomic_store_explicit(&thread->local, (epoch << 1) | 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_seq_cst);
+
+    /* Nodes retired two epochs back can not be held by anyone */
+    for (int b = 0; b < 3; b++) {
+        if (thread->retired[b] != NULL && thread->retired_epoch[b] + 2 <= epoch) {
+            ll2c_free_chain(thread->retired[b]);
+            thread->retired[b] = NULL;
+        }
+    }
+}
+
+/**
+ * @brief Marks the thread as outside the list
+ *
+ * @param thread The slot of the calling thread
+ */
+static void ll2c_exit(ll2c_thread_t *thread) {
+    atomic_store_explicit(&thread->local, 0, memory_order_release);
+}
+
+/**
+ * @brief Moves the global epoch on if every running thread has seen it
+ *
+ * @param list The list to advance
+ */
+static void ll2c_try_advance(ll2c_list_t *list) {
+    uint64_t epoch = atomic_load_explicit(&list->epoch, memory_order_seq_cst);
+
+    for (int t = 0; t < LL2C_MAX_THREADS; t++) {
+        uint64_t local = atomic_load_explicit(&list->threads[t].local, memory_order_seq_cst);
+        if ((local & 1) && (local >> 1) != epoch) {
+            return;
+        }
+    }
+
+    atomic_compare_exchange_strong_explicit(&list->epoch, &epoch, epoch + 1,
+                                            memory_order_seq_cst,
+                                            memory_order_relaxed);
+}
+
+/**
+ * @brief Hands an unlinked node over to be freed later
+ *
+ * @param list The list the node was in
+ * @param thread The slot of the calling thread
+ * @param node The node, no longer reachable from the head
+ */
+static void ll2c_retire(ll2c_list_t *list, ll2c_thread_t *thread, ll2c_node_t *node) {
+    uint64_t epoch = atomic_load_explicit(&list->epoch, memory_order_seq_cst);
+    int b = (int) (epoch % 3);
+
+    /* A list from three or more epochs back is safe to free */
+    if (thread->retired[b] != NULL && thread->retired_epoch[b] != epoch) {
+        ll2c_free_chain(thread->retired[b]);
+        thread->retired[b] = NULL;
+    }
+    node->retired = thread->retired[b];
+    thread->retired[b] = node;
+    thread->retired_epoch[b] = epoch;
+
+    if (++thread->retired_count % LL2C_RETIRE_BATCH == 0) {
+        ll2c_try_advance(list);
+    }
+}
+
+/**
+ * @brief Finds the unmarked node at an index and the node before it
+ *
+ * Marked nodes passed on the way are unlinked and retired. If an unlink
+ * fails because the list changed, the walk starts again from the head.
+ *
+ * @param list The list to walk
+ * @param thread The slot of the calling thread
+ * @param index The index to find
+ * @param curr Set to the node at index, or NULL if index is the end
+ *
+ * @return The node before index, or NULL if index is past the end
+ */
+static ll2c_node_t *ll2c_locate(ll2c_list_t *list, ll2c_thread_t *thread, size_t index, ll2c_node_t **curr) {
+retry:;
+    ll2c_node_t *prev = list->head;
+    ll2c_node_t *node = LL2C_PTR(atomic_load_explicit(&prev->next, memory_order_acquire));
+    size_t pos = 0;
+
+    for (;;) {
+        if (node == NULL) {
+            *curr = NULL;
+            return (pos == index) ? prev : NULL;
+        }
+
+        uintptr_t next = atomic_load_explicit(&node->next, memory_order_acquire);
+        if (next & LL2C_MARK) {
+            uintptr_t expected = (uintptr_t) node;
+            if (!atomic_compare_exchange_strong_explicit(&prev->next, &expected, next & ~LL2C_MARK,
+                                                         memory_order_acq_rel,
+                                                         memory_order_acquire)) {
+                goto retry;
+            }
+            ll2c_retire(list, thread, node);
+            node = LL2C_PTR(next);
+            continue;
+        }
+
+        if (pos == index) {
+            *curr = node;
+            return prev;
+        }
+        prev = node;
+        node = LL2C_PTR(next);
+        pos++;
+    }
+}
+
+ll2_err_t ll2c_init(ll2c_list_t *list) {
+    if (list == NULL) {
+        return LL2_NULLPTR;
+    }
+
+    list->head = (ll2c_node_t *) malloc(sizeof(ll2c_node_t));
+    if (list->head == NULL) {
+        return LL2_MEM;
+    }
+    atomic_init(&list->head->next, 0);
+    list->head->retired = NULL;
+    list->head->data = 0;
+
+    atomic_init(&list->epoch, 0);
+    atomic_init(&list->count, 0);
+    for (int t = 0; t < LL2C_MAX_THREADS; t++) {
+        atomic_init(&list->threads[t].local, 0);
+        atomic_init(&list->threads[t].used, 0);
+        list->threads[t].retired_count = 0;
+        for (int b = 0; b < 3; b++) {
+            list->threads[t].retired[b] = NULL;
+            list->threads[t].retired_epoch[b] = 0;
+        }
+    }
+
+    return LL2_SUCCESS;
+}
+
+ll2_err_t ll2c_destroy(ll2c_list_t *list) {
+    if (list == NULL) {
+        return LL2_NULLPTR;
+    }
+
+    /* Marked nodes still linked were never retired, so free them here */
+    ll2c_node_t *node = list->head;
+    while (node != NULL) {
+        ll2c_node_t *next = LL2C_PTR(atomic_load_explicit(&node->next, memory_order_relaxed));
+        free(node);
+        node = next;
+    }
+
+    for (int t = 0; t < LL2C_MAX_THREADS; t++) {
+        for (int b = 0; b < 3; b++) {
+            ll2c_free_chain(list->threads[t].retired[b]);
+            list->threads[t].retired[b] = NULL;
+        }
+    }
+
+    list->head = NULL;
+    atomic_store_explicit(&list->count, 0, memory_order_relaxed);
+    return LL2_SUCCESS;
+}
+
+ll2c_thread_t *ll2c_thread_register(ll2c_list_t *list) {
+    if (list == NULL) {
+        return NULL;
+    }
+
+    for (int t = 0; t < LL2C_MAX_THREADS; t++) {
+        int expected = 0;
+        if (atomic_compare_exchange_strong_explicit(&list->threads[t].used, &expected, 1,
+                                                    memory_order_acquire,
+                                                    memory_order_relaxed)) {
+            return &list->threads[t];
+        }
+    }
+
+    return NULL;
+}
+
+void ll2c_thread_unregister(ll2c_thread_t *thread) {
+    if (thread == NULL) {
+        return;
+    }
+
+    atomic_store_explicit(&thread->used, 0, memory_order_release);
+}
+
+ll2_err_t ll2c_add(ll2c_list_t *list, ll2c_thread_t *thread, uint32_t data, size_t index) {
+    if (list == NULL || thread == NULL) {
+        return LL2_NULLPTR;
+    }
+
+    ll2c_node_t *insert = (ll2c_node_t *) malloc(sizeof(ll2c_node_t));
+    if (insert == NULL) {
+        return LL2_MEM;
+    }
+    insert->retired = NULL;
+    insert->data = data;
+
+    /* Count before linking so a racing remove never takes the count below 0 */
+    atomic_fetch_add_explicit(&list->count, 1, memory_order_relaxed);
+    ll2c_enter(list, thread);
+    for (;;) {
+        ll2c_node_t *curr;
+        ll2c_node_t *prev = ll2c_locate(list, thread, index, &curr);
+        if (prev == NULL) {
+            ll2c_exit(thread);
+            atomic_fetch_sub_explicit(&list->count, 1, memory_order_relaxed);
+            free(insert);
+            return LL2_INDEX;
+        }
+
+        /* Fails if prev was marked or something was linked after it */
+        atomic_store_explicit(&insert->next, (uintptr_t) curr, memory_order_relaxed);
+        uintptr_t expected = (uintptr_t) curr;
+        if (atomic_compare_exchange_strong_explicit(&prev->next, &expected, (uintptr_t) insert,
+                                                    memory_order_release,
+                                                    memory_order_relaxed)) {
+            break;
+        }
+    }
+    ll2c_exit(thread);
+
+    return LL2_SUCCESS;
+}
+
+ll2_err_t ll2c_remove(ll2c_list_t *list, ll2c_thread_t *thread, size_t index) {
+    if (list == NULL || thread == NULL) {
+        return LL2_NULLPTR;
+    }
+
+    ll2c_enter(list, thread);
+    for (;;) {
+        ll2c_node_t *curr;
+        ll2c_node_t *prev = ll2c_locate(list, thread, index, &curr);
+        if (prev == NULL || curr == NULL) {
+            ll2c_exit(thread);
+            return LL2_INDEX;
+        }
+
+        /* Marking is the removal, whoever marks first owns it */
+        uintptr_t next = atomic_load_explicit(&curr->next, memory_order_acquire);
+        if ((next & LL2C_MARK) ||
+            !atomic_compare_exchange_strong_explicit(&curr->next, &next, next | LL2C_MARK,
+                                                     memory_order_acq_rel,
+                                                     memory_order_relaxed)) {
+            continue;
+        }
+
+        /* If this fails a later walk unlinks and retires the node */
+        uintptr_t expected = (uintptr_t) curr;
+        if (atomic_compare_exchange_strong_explicit(&prev->next, &expected, next,
+                                                    memory_order_acq_rel,
+                                                    memory_order_relaxed)) {
+            ll2c_retire(list, thread, curr);
+        }
+        break;
+    }
+    atomic_fetch_sub_explicit(&list->count, 1, memory_order_relaxed);
+    ll2c_exit(thread);
+
+    return LL2_SUCCESS;
+}
+
+ll2_err_t ll2c_get(ll2c_list_t *list, ll2c_thread_t *thread, size_t index, uint32_t *data) {
+    if (list == NULL || thread == NULL || data == NULL) {
+        return LL2_NULLPTR;
+    }
+
+    ll2c_enter(list, thread);
+    ll2c_node_t *node = LL2C_PTR(atomic_load_explicit(&list->head->next, memory_order_acquire));
+    size_t pos = 0;
+
+    while (node != NULL) {
+        uintptr_t next = atomic_load_explicit(&node->next, memory_order_acquire);
+        if (!(next & LL2C_MARK)) {
+            if (pos == index) {
+                *data = node->data;
+                ll2c_exit(thread);
+                return LL2_SUCCESS;
+            }
+            pos++;
+        }
+        node = LL2C_PTR(next);
+    }
+    ll2c_exit(thread);
+
+    return LL2_INDEX;
+}
+
+ll2_err_t ll2c_search(ll2c_list_t *list, ll2c_thread_t *thread, uint32_t data, size_t *index) {
+    if (list == NULL || thread == NULL || index == NULL) {
+        return LL2_NULLPTR;
+    }
+
+    ll2c_enter(list, thread);
+    ll2c_node_t *node = LL2C_PTR(atomic_load_explicit(&list->head->next, memory_order_acquire));
+    size_t pos = 0;
+
+    while (node != NULL) {
+        uintptr_t next = atomic_load_explicit(&node->next, memory_order_acquire);
+        if (!(next & LL2C_MARK)) {
+            if (node->data == data) {
+                *index = pos;
+                ll2c_exit(thread);
+                return LL2_SUCCESS;
+            }
+            pos++;
+        }
+        node = LL2C_PTR(next);
+    }
+    ll2c_exit(thread);
+
+    return LL2_DATA;
+}
+
+size_t ll2c_size(ll2c_list_t *list) {
+    if (list == NULL) {
+        return 0;
+    }
+
+    return atomic_load_explicit(&list->count, memory_order_relaxed);
+}
@@ -0,0 +1,213 @@
+/******************************************************************************
+* Copyright (C) 2017 by Ben Heberlein
+*
+* Redistribution, modification or use of this software in source or binary
+* forms is permitted as long as the files maintain this copyright. This file
+* was created for the University of Colorado Boulder course Advanced Practical
+* Embedded Software Development. Ben Heberlein and the University of Colorado
+* are not liable for any misuse of this material.
+*
+*******************************************************************************/
+/**
+ * @file ll2i.c
+ * @brief The implementation for an intrusive doubly linked list
+ *
+ * This file provides the function implementations for a doubly linked list
+ * of links embedded in the caller's structures. Nothing here allocates.
+ *
+ * @author Ben Heberlein
+ * @date October 17 2026
+ * @version 1.0
+ *
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include "ll2i.h"
+
+/**
+ * @brief Links a link in between two neighbours on the ring
+ *
+ * @param list The list to add to
+ * @param prev The link that ends up before link
+ * @param link The link to add
+ */
+static void ll2i_splice(ll2i_list_t *list, ll2i_link_t *prev, ll2i_link_t *link) {
+    ll2i_link_t *next = prev->next;
+
+    link->prev = prev;
+    link->next = next;
+    prev->next = link;
+    next->prev = link;
+    list->count++;
+}
+
+/**
+ * @brief Takes a link off the ring and marks it as on no list
+ *
+ * @param list The list to take from
+ * @param link The link to take off
+ */
+static void ll2i_cut(ll2i_list_t *list, ll2i_link_t *link) {
+    link->prev->next = link->next;
+    link->next->prev = link->prev;
+    link->prev = NULL;
+    link->next = NULL;
+    list->count--;
+}
+
+ll2_err_t ll2i_init(ll2i_list_t *list) {
+    if (list == NULL) {
+        return LL2_NULLPTR;
+    }
+
+    list->ring.prev = &list->ring;
+    list->ring.next = &list->ring;
+    list->count = 0;
+
+    return LL2_SUCCESS;
+}
+
+ll2_err_t ll2i_link_init(ll2i_link_t *link) {
+    if (link == NULL) {
+        return LL2_NULLPTR;
+    }
+
+    link->prev = NULL;
+    link->next = NULL;
+
+    return LL2_SUCCESS;
+}
+
+int ll2i_is_linked(const ll2i_link_t *link) {
+    return link != NULL && link->next != NULL;
+}
+
+ll2_err_t ll2i_push_front(ll2i_list_t *list, ll2i_link_t *link) {
+    if (list == NULL || link == NULL) {
+        return LL2_NULLPTR;
+    }
+
+    if (link->next != NULL) {
+        return LL2_DATA;
+    }
+
+    ll2i_splice(list, &list->ring, link);
+    return LL2_SUCCESS;
+}
+
+ll2_err_t ll2i_push_back(ll2i_list_t *list, ll2i_link_t *link) {
+    if (list == NULL || link == NULL) {
+        return LL2_NULLPTR;
+    }
+
+    if (link->next != NULL) {
+        return LL2_DATA;
+    }
+
+    ll2i_splice(list, list->ring.prev, link);
+    return LL2_SUCCESS;
+}
+
+ll2_err_t ll2i_insert_before(ll2i_list_t *list, ll2i_link_t *pos, ll2i_link_t *link) {
+    if (list == NULL || pos == NULL || link == NULL) {
+        return LL2_NULLPTR;
+    }
+
+    if (link->next != NULL || pos->next == NULL) {
+        return LL2_DATA;
+    }
+
+    ll2i_splice(list, pos->prev, link);
+    return LL2_SUCCESS;
+}
+
+ll2_err_t ll2i_insert_after(ll2i_list_t *list, ll2i_link_t *pos, ll2i_link_t *link) {
+    if (list == NULL || pos == NULL || link == NULL) {
+        return LL2_NULLPTR;
+    }
+
+    if (link->next != NULL || pos->next == NULL) {
+        return LL2_DATA;
+    }
+
+    ll2i_splice(list, pos, link);
+    return LL2_SUCCESS;
+}
+
+ll2_err_t ll2i_unlink(ll2i_list_t *list, ll2i_link_t *link) {
+    if (list == NULL || link == NULL) {
+        return LL2_NULLPTR;
+    }
+
+    if (link->next == NULL) {
+        return LL2_DATA;
+    }
+
+    ll2i_cut(list, link);
+    return LL2_SUCCESS;
+}
+
+ll2_err_t ll2i_move(ll2i_list_t *dst, ll2i_list_t *src, ll2i_link_t *link) {
+    if (dst == NULL || src == NULL || link == NULL) {
+        return LL2_NULLPTR;
+    }
+
+    if (link->next == NULL) {
+        return LL2_DATA;
+    }
+
+    ll2i_cut(src, link);
+    ll2i_splice(dst, dst->ring.prev, link);
+    return LL2_SUCCESS;
+}
+
+ll2i_link_t *ll2i_pop_front(ll2i_list_t *list) {
+    if (list == NULL || list->count == 0) {
+        return NULL;
+    }
+
+    ll2i_link_t *link = list->ring.next;
+    ll2i_cut(list, link);
+    return link;
+}
+
+ll2i_link_t *ll2i_first(ll2i_list_t *list) {
+    if (list == NULL || list->count == 0) {
+        return NULL;
+    }
+
+    return list->ring.next;
+}
+
+ll2i_link_t *ll2i_last(ll2i_list_t *list) {
+    if (list == NULL || list->count == 0) {
+        return NULL;
+    }
+
+    return list->ring.prev;
+}
+
+ll2i_link_t *ll2i_next(ll2i_list_t *list, ll2i_link_t *link) {
+    if (list == NULL || link == NULL || link->next == &list->ring) {
+        return NULL;
+    }
+
+    return link->next;
+}
+
+ll2i_link_t *ll2i_prev(ll2i_list_t *list, ll2i_link_t *link) {
+    if (list == NULL || link == NULL || link->prev == &list->ring) {
+        return NULL;
+    }
+
+    return link->prev;
+}
+
+size_t ll2i_size(ll2i_list_t *list) {
+    if (list == NULL) {
+        return 0;
+    }
+
+    return list->count;
+}
@@ -0,0 +1,267 @@
+/******************************************************************************
+* Copyright (C) 2017 by Ben Heberlein
+*
+* Redistribution, modification or use of this software in source or binary
+* forms is permitted as long as the files maintain this copyright. This file
+* was created for the University of Colorado Boulder course Advanced Practical
+* Embedded Software Development. Ben Heberlein and the University of Colorado
+* are not liable for any misuse of this material.
+*
+*******************************************************************************/
+/**
+ * @file ll2s.c
+ * @brief The implementation for an indexable skip list
+ *
+ * This file provides the function implementations for an indexable skip
+ * list. A link's width is the number of positions between the node it leaves
+ * and the node it reaches, so summing widths along a search path gives the
+ * position reached. Links that end the list keep a width too, it is never
+ * read but keeps the arithmetic the same for every link.
+ *
+ * @author Ben Heberlein
+ * @date October 17 2026
+ * @version 1.0
+ *
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include "ll2s.h"
+
+/**
+ * @brief Allocates a node with a number of levels
+ *
+ * @param level The number of links
+ *
+ * @return The new node, or NULL if out of memory
+ */
+static ll2s_node_t *ll2s_node_alloc(uint32_t level) {
+    ll2s_node_t *node = (ll2s_node_t *) malloc(sizeof(ll2s_node_t) + level * sizeof(ll2s_link_t));
+    if (node == NULL) {
+        return NULL;
+    }
+
+    node->level = level;
+    for (uint32_t l = 0; l < level; l++) {
+        node->link[l].next = NULL;
+        node->link[l].width = 0;
+    }
+    return node;
+}
+
+/**
+ * @brief Picks the level of a new node
+ *
+ * Two random bits per level give each level a 1/4 chance to go one higher.
+ *
+ * @param list The list whose generator to use
+ *
+ * @return A level between 1 and LL2S_MAX_LEVEL
+ */
+static uint32_t ll2s_random_level(ll2s_list_t *list) {
+    /* xorshift64 */
+    uint64_t x = list->seed;
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    list->seed = x;
+
+    uint32_t level = 1;
+    while ((x & 3) == 0 && level < LL2S_MAX_LEVEL) {
+        level++;
+        x >>= 2;
+    }
+    return level;
+}
+
+/**
+ * @brief Finds the last node on each level that comes before a position
+ *
+ * @param list The list to walk
+ * @param rank Number of values that must be passed, 0 stops at the head
+ * @param update Filled with the last node on each level before rank
+ * @param passed Filled with how many values each of those nodes is past
+ *
+ * @return The last node before rank on the bottom level
+ */
+static ll2s_node_t *ll2s_path(ll2s_list_t *list, size_t rank, ll2s_node_t **update, size_t *passed) {
+    ll2s_node_t *node = list->head;
+    size_t t = 0;
+
+    for (uint32_t l = list->level; l-- > 0; ) {
+        while (node->link[l].next != NULL && t + node->link[l].width <= rank) {
+            t += node->link[l].width;
+            node = node->link[l].next;
+        }
+        update[l] = node;
+        passed[l] = t;
+    }
+    return node;
+}
+
+ll2_err_t ll2s_init(ll2s_list_t *list) {
+    if (list == NULL) {
+        return LL2_NULLPTR;
+    }
+
+    list->head = ll2s_node_alloc(LL2S_MAX_LEVEL);
+    if (list->head == NULL) {
+        return LL2_MEM;
+    }
+    list->count = 0;
+    list->level = 1;
+    list->seed = 0x9e3779b97f4a7c15ULL ^ (uint64_t) (uintptr_t) list;
+
+    return LL2_SUCCESS;
+}
+
+ll2_err_t ll2s_destroy(ll2s_list_t *list) {
+    if (list == NULL) {
+        return LL2_NULLPTR;
+    }
+
+    ll2s_node_t *node = list->head;
+    while (node != NULL) {
+        ll2s_node_t *next = node->link[0].next;
+        free(node);
+        node = next;
+    }
+
+    list->head = NULL;
+    list->count = 0;
+    list->level = 1;
+    return LL2_SUCCESS;
+}
+
+ll2_err_t ll2s_add(ll2s_list_t *list, uint32_t data, size_t index) {
+    if (list == NULL) {
+        return LL2_NULLPTR;
+    }
+
+    if (index > list->count) {
+        return LL2_INDEX;
+    }
+
+    /* A destroyed list gets its head back on the first add */
+    if (list->head == NULL) {
+        list->head = ll2s_node_alloc(LL2S_MAX_LEVEL);
+        if (list->head == NULL) {
+            return LL2_MEM;
+        }
+    }
+
+    ll2s_node_t *update[LL2S_MAX_LEVEL];
+    size_t passed[LL2S_MAX_LEVEL];
+    uint32_t level = ll2s_random_level(list);
+
+    ll2s_node_t *insert = ll2s_node_alloc(level);
+    if (insert == NULL) {
+        return LL2_MEM;
+    }
+    insert->data = data;
+
+    /* New top levels start out as one head link over the whole list */
+    while (list->level < level) {
+        list->head->link[list->level].next = NULL;
+        list->head->link[list->level].width = list->count + 1;
+        list->level++;
+    }
+
+    ll2s_path(list, index, update, passed);
+
+    /* Split the links the new node sits under, stretch the ones above it */
+    for (uint32_t l = 0; l < list->level; l++) {
+        if (l < level) {
+            size_t before = index - passed[l];
+            insert->link[l].next = update[l]->link[l].next;
+            insert->link[l].width = update[l]->link[l].width - before;
+            update[l]->link[l].next = insert;
+            update[l]->link[l].width = before + 1;
+        } else {
+            update[l]->link[l].width++;
+        }
+    }
+    list->count++;
+
+    return LL2_SUCCESS;
+}
+
+ll2_err_t ll2s_remove(ll2s_list_t *list, size_t index) {
+    if (list == NULL) {
+        return LL2_NULLPTR;
+    }
+
+    if (index >= list->count) {
+        return LL2_INDEX;
+    }
+
+    ll2s_node_t *update[LL2S_MAX_LEVEL];
+    size_t passed[LL2S_MAX_LEVEL];
+
+    ll2s_node_t *node = ll2s_path(list, index, update, passed)->link[0].next;
+
+    /* Join the links around the node, shorten the ones over it */
+    for (uint32_t l = 0; l < list->level; l++) {
+        if (l < node->level) {
+            update[l]->link[l].next = node->link[l].next;
+            update[l]->link[l].width += node->link[l].width - 1;
+        } else {
+            update[l]->link[l].width--;
+        }
+    }
+    free(node);
+    list->count--;
+
+    /* Drop levels nothing uses any more */
+    while (list->level > 1 && list->head->link[list->level - 1].next == NULL) {
+        list->level--;
+    }
+
+    return LL2_SUCCESS;
+}
+
+ll2_err_t ll2s_get(ll2s_list_t *list, size_t index, uint32_t *data) {
+    if (list == NULL || data == NULL) {
+        return LL2_NULLPTR;
+    }
+
+    if (index >= list->count) {
+        return LL2_INDEX;
+    }
+
+    ll2s_node_t *update[LL2S_MAX_LEVEL];
+    size_t passed[LL2S_MAX_LEVEL];
+
+    *data = ll2s_path(list, index + 1, update, passed)->data;
+
+    return LL2_SUCCESS;
+}
+
+ll2_err_t ll2s_search(ll2s_list_t *list, uint32_t data, size_t *index) {
+    if (list == NULL || index == NULL) {
+        return LL2_NULLPTR;
+    }
+
+    if (list->count == 0) {
+        return LL2_DATA;
+    }
+
+    size_t temp = 0;
+    for (ll2s_node_t *node = list->head->link[0].next; node != NULL; node = node->link[0].next) {
+        if (node->data == data) {
+            *index = temp;
+            return LL2_SUCCESS;
+        }
+        temp++;
+    }
+
+    return LL2_DATA;
+}
+
+size_t ll2s_size(ll2s_list_t *list) {
+    if (list == NULL) {
+        return 0;
+    }
+
+    return list->count;
+}
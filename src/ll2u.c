@@ -0,0 +1,298 @@
+/******************************************************************************
+* Copyright (C) 2017 by Ben Heberlein
+*
+* Redistribution, modification or use of this software in source or binary
+* forms is permitted as long as the files maintain this copyright. This file
+* was created for the University of Colorado Boulder course Advanced Practical
+* Embedded Software Development. Ben Heberlein and the University of Colorado
+* are not liable for any misuse of this material.
+*
+*******************************************************************************/
+/**
+ * @file ll2u.c
+ * @brief The implementation for an unrolled doubly linked list
+ *
+ * This file provides the function implementations for an unrolled doubly
+ * linked list. Values are kept in order inside cache line aligned blocks.
+ * Inserting into a full block splits it in half, and removing merges a block
+ * with the next one once both fit in a single block.
+ *
+ * @author Ben Heberlein
+ * @date October 17 2026
+ * @version 1.0
+ *
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "ll2u.h"
+#include "simd_find.h"
+
+#define LL2U_ALIGN 64
+
+/**
+ * @brief Allocates an empty block
+ *
+ * @return The new block, or NULL if out of memory
+ */
+static ll2u_block_t *ll2u_block_alloc(void) {
+    size_t bytes = (sizeof(ll2u_block_t) + LL2U_ALIGN - 1) & ~((size_t) LL2U_ALIGN - 1);
+    ll2u_block_t *block = (ll2u_block_t *) aligned_alloc(LL2U_ALIGN, bytes);
+    if (block == NULL) {
+        return NULL;
+    }
+
+    block->prev = NULL;
+    block->next = NULL;
+    block->count = 0;
+    return block;
+}
+
+/**
+ * @brief Links a block in after another one
+ *
+ * @param list The list to link into
+ * @param prev The block to insert after, or NULL to insert at the head
+ * @param block The block to insert
+ */
+static void ll2u_link(ll2u_list_t *list, ll2u_block_t *prev, ll2u_block_t *block) {
+    block->prev = prev;
+    if (prev == NULL) {
+        block->next = list->head;
+        list->head = block;
+    } else {
+        block->next = prev->next;
+        prev->next = block;
+    }
+    if (block->next != NULL) {
+        block->next->prev = block;
+    } else {
+        list->tail = block;
+    }
+}
+
+/**
+ * @brief Takes a block out of the list and frees it
+ *
+ * @param list The list to unlink from
+ * @param block The block to remove
+ */
+static void ll2u_unlink(ll2u_list_t *list, ll2u_block_t *block) {
+    if (block->prev == NULL) {
+        list->head = block->next;
+    } else {
+        block->prev->next = block->next;
+    }
+    if (block->next == NULL) {
+        list->tail = block->prev;
+    } else {
+        block->next->prev = block->prev;
+    }
+    free(block);
+}
+
+/**
+ * @brief Finds the block that holds an index
+ *
+ * Walks from whichever end of the list is closer. An index equal to the size
+ * maps to the end of the tail block.
+ *
+ * @param list The list to walk, must not be empty
+ * @param index The index to find, at most list->count
+ * @param offset A pointer to return the position inside the block
+ *
+ * @return The block holding index
+ */
+static ll2u_block_t *ll2u_locate(ll2u_list_t *list, size_t index, size_t *offset) {
+    ll2u_block_t *block;
+
+    if (index < list->count / 2) {
+        block = list->head;
+        while (index >= block->count) {
+            index -= block->count;
+            block = block->next;
+        }
+        *offset = index;
+        return block;
+    }
+
+    /* Count back from the end */
+    size_t back = list->count - index;
+    block = list->tail;
+    while (back > block->count) {
+        back -= block->count;
+        block = block->prev;
+    }
+    *offset = block->count - back;
+    return block;
+}
+
+ll2_err_t ll2u_init(ll2u_list_t *list) {
+    if (list == NULL) {
+        return LL2_NULLPTR;
+    }
+
+    list->head = NULL;
+    list->tail = NULL;
+    list->count = 0;
+
+    return LL2_SUCCESS;
+}
+
+ll2_err_t ll2u_destroy(ll2u_list_t *list) {
+    if (list == NULL) {
+        return LL2_NULLPTR;
+    }
+
+    ll2u_block_t *block = list->head;
+    while (block != NULL) {
+        ll2u_block_t *next = block->next;
+        free(block);
+        block = next;
+    }
+
+    return ll2u_init(list);
+}
+
+ll2_err_t ll2u_add(ll2u_list_t *list, uint32_t data, size_t index) {
+    if (list == NULL) {
+        return LL2_NULLPTR;
+    }
+
+    if (index > list->count) {
+        return LL2_INDEX;
+    }
+
+    /* First value needs a first block */
+    if (list->head == NULL) {
+        ll2u_block_t *first = ll2u_block_alloc();
+        if (first == NULL) {
+            return LL2_MEM;
+        }
+        ll2u_link(list, NULL, first);
+    }
+
+    size_t offset;
+    ll2u_block_t *block = ll2u_locate(list, index, &offset);
+
+    /* Split a full block, moving its upper half to a new one */
+    if (block->count == LL2U_BLOCK_ITEMS) {
+        ll2u_block_t *split = ll2u_block_alloc();
+        if (split == NULL) {
+            return LL2_MEM;
+        }
+
+        uint32_t keep = LL2U_BLOCK_ITEMS / 2;
+        split->count = LL2U_BLOCK_ITEMS - keep;
+        memcpy(split->data, block->data + keep, split->count * sizeof(uint32_t));
+        block->count = keep;
+        ll2u_link(list, block, split);
+
+        if (offset > keep) {
+            offset -= keep;
+            block = split;
+        }
+    }
+
+    memmove(block->data + offset + 1, block->data + offset,
+            (block->count - offset) * sizeof(uint32_t));
+    block->data[offset] = data;
+    block->count++;
+    list->count++;
+
+    return LL2_SUCCESS;
+}
+
+ll2_err_t ll2u_remove(ll2u_list_t *list, size_t index) {
+    if (list == NULL) {
+        return LL2_NULLPTR;
+    }
+
+    if (index >= list->count) {
+        return LL2_INDEX;
+    }
+
+    size_t offset;
+    ll2u_block_t *block = ll2u_locate(list, index, &offset);
+
+    memmove(block->data + offset, block->data + offset + 1,
+            (block->count - offset - 1) * sizeof(uint32_t));
+    block->count--;
+    list->count--;
+
+    if (block->count == 0) {
+        ll2u_unlink(list, block);
+        return LL2_SUCCESS;
+    }
+
+    /* Fold the next block in once both fit in one */
+    ll2u_block_t *next = block->next;
+    if (next != NULL && block->count + next->count <= LL2U_BLOCK_ITEMS) {
+        memcpy(block->data + block->count, next->data, next->count * sizeof(uint32_t));
+        block->count += next->count;
+        ll2u_unlink(list, next);
+    }
+
+    return LL2_SUCCESS;
+}
+
+ll2_err_t ll2u_get(ll2u_list_t *list, size_t index, uint32_t *data) {
+    if (list == NULL || data == NULL) {
+        return LL2_NULLPTR;
+    }
+
+    if (index >= list->count) {
+        return LL2_INDEX;
+    }
+
+    size_t offset;
+    ll2u_block_t *block = ll2u_locate(list, index, &offset);
+    *data = block->data[offset];
+
+    return LL2_SUCCESS;
+}
+
+ll2_err_t ll2u_search(ll2u_list_t *list, uint32_t data, size_t *index) {
+    if (list == NULL || index == NULL) {
+        return LL2_NULLPTR;
+    }
+
+    size_t base = 0;
+    for (ll2u_block_t *block = list->head; block != NULL; block = block->next) {
+        size_t at = simd_find_eq(block->data, block->count, data);
+        if (at < block->count) {
+            *index = base + at;
+            return LL2_SUCCESS;
+        }
+        base += block->count;
+    }
+
+    return LL2_DATA;
+}
+
+ll2_err_t ll2u_search_range(ll2u_list_t *list, uint32_t lo, uint32_t hi, size_t *index) {
+    if (list == NULL || index == NULL) {
+        return LL2_NULLPTR;
+    }
+
+    size_t base = 0;
+    for (ll2u_block_t *block = list->head; block != NULL; block = block->next) {
+        size_t at = simd_find_range(block->data, block->count, lo, hi);
+        if (at < block->count) {
+            *index = base + at;
+            return LL2_SUCCESS;
+        }
+        base += block->count;
+    }
+
+    return LL2_DATA;
+}
+
+size_t ll2u_size(ll2u_list_t *list) {
+    if (list == NULL) {
+        return 0;
+    }
+
+    return list->count;
+}
@@ -27,8 +27,143 @@
 
 #include <stdint.h>
 #include <stdio.h>
+#include <string.h>
+#include <pthread.h>
+#include <sched.h>
 #include "circbuf.h"
+#include "circbuf_typed.h"
+#include "circbuf_mpmc.h"
+#include "circbuf_shm.h"
 #include "ll2.h"
+#include "ll2u.h"
+#include "ll2s.h"
+#include "ll2c.h"
+#include "ll2a.h"
+#include "ll2i.h"
+
+#define SPSC_ITEMS 1000000
+#define MPMC_THREADS 4
+#define MPMC_ITEMS 25000
+
+/**
+ * @brief Example record for the typed circular buffer
+ */
+typedef struct sample_s {
+    uint32_t id;
+    uint32_t channel;
+    uint64_t timestamp;
+} sample_t;
+
+CIRCBUF_DEFINE(sample, sample_t, 16)
+
+/**
+ * @brief Producer thread for the lock-free buffer demonstration
+ *
+ * Pushes the values 0 to SPSC_ITEMS - 1 in order, sleeping while full, or
+ * spinning where the blocking calls do not exist.
+ *
+ * @param arg The circbuf_spsc_t to fill
+ *
+ * @return Always NULL
+ */
+static void *spsc_producer(void *arg) {
+    circbuf_spsc_t *ring = (circbuf_spsc_t *) arg;
+
+    for (uint32_t i = 0; i < SPSC_ITEMS; i++) {
+#ifdef CIRCBUF_HAVE_WAIT
+        circbuf_spsc_add_wait(i, ring);
+#else
+        while (circbuf_spsc_add(i, ring) != ERR_SUCCESS) {
+            sched_yield();
+        }
+#endif
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Shared state for the multi producer, multi consumer demonstration
+ */
+typedef struct mpmc_demo_s {
+    circbuf_mpmc_t *queue;
+    _Atomic uint32_t next_producer;
+    _Atomic uint32_t taken;
+    _Atomic uint64_t sum;
+    _Atomic uint8_t seen[MPMC_THREADS * MPMC_ITEMS];
+} mpmc_demo_t;
+
+/**
+ * @brief Producer thread for the multi producer buffer demonstration
+ *
+ * Each producer pushes its own range of MPMC_ITEMS values, so no value is
+ * pushed twice.
+ *
+ * @param arg The mpmc_demo_t to fill
+ *
+ * @return Always NULL
+ */
+static void *mpmc_producer(void *arg) {
+    mpmc_demo_t *demo = (mpmc_demo_t *) arg;
+    uint32_t first = atomic_fetch_add(&demo->next_producer, 1) * MPMC_ITEMS;
+
+    for (uint32_t i = first; i < first + MPMC_ITEMS; i++) {
+        while (circbuf_mpmc_add(i, demo->queue) != ERR_SUCCESS) {
+            sched_yield();
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Consumer thread for the multi producer buffer demonstration
+ *
+ * Takes values until all of them are accounted for, marking each one seen.
+ *
+ * @param arg The mpmc_demo_t to drain
+ *
+ * @return Always NULL
+ */
+static void *mpmc_consumer(void *arg) {
+    mpmc_demo_t *demo = (mpmc_demo_t *) arg;
+    uint32_t data;
+
+    while (atomic_load(&demo->taken) < MPMC_THREADS * MPMC_ITEMS) {
+        if (circbuf_mpmc_remove(&data, demo->queue) != ERR_SUCCESS) {
+            sched_yield();
+            continue;
+        }
+        if (data < MPMC_THREADS * MPMC_ITEMS) {
+            atomic_fetch_add(&demo->seen[data], 1);
+        }
+        atomic_fetch_add(&demo->sum, data);
+        atomic_fetch_add(&demo->taken, 1);
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Writer thread for the concurrent list demonstration
+ *
+ * Adds the values 0 to 499 at the front of the list.
+ *
+ * @param arg The ll2c_list_t to add to
+ *
+ * @return Always NULL
+ */
+static void *ll2c_writer(void *arg) {
+    ll2c_list_t *list = (ll2c_list_t *) arg;
+    ll2c_thread_t *self = ll2c_thread_register(list);
+
+    for (uint32_t i = 0; i < 500; i++) {
+        ll2c_add(list, self, i, 0);
+    }
+    ll2c_thread_unregister(self);
+
+    return NULL;
+}
 
 int main() {
     /* Test circular buffer */
@@ -51,7 +186,7 @@ int main() {
     }
 
     err = circbuf_dump(cb);    
-    printf("Size of circular buffer is %d\n", circbuf_size(cb));
+    printf("Size of circular buffer is %d\n", (int) circbuf_size(cb));
 
     /* Remove data */
     uint32_t temp = 0;
@@ -61,7 +196,7 @@ int main() {
     }
 
     err = circbuf_dump(cb);
-    printf("Size of circular buffer is %d\n", circbuf_size(cb));
+    printf("Size of circular buffer is %d\n", (int) circbuf_size(cb));
 
     /* Add more data to show loop around */
     for (int i = 0; i < 5; i++) {
@@ -69,7 +204,27 @@ int main() {
     }
 
     err = circbuf_dump(cb);
-    printf("Size of circular buffer is %d\n", circbuf_size(cb));
+    printf("Size of circular buffer is %d\n", (int) circbuf_size(cb));
+
+    /* Move data in bulk across the wrap point */
+    uint32_t block[8] = {0};
+    circbuf_count_t moved = circbuf_remove_n(block, 8, cb);
+    printf("Bulk removed %d, first %d last %d\n", (int) moved, block[0], block[moved - 1]);
+    moved = circbuf_add_n(block, 8, cb);
+    printf("Bulk added %d, size of circular buffer is %d\n", (int) moved, (int) circbuf_size(cb));
+
+    /* Search across the wrap point, the bulk added items are the newest */
+    circbuf_count_t where = 0;
+    err = circbuf_find(3, &where, cb);
+    printf("3 found %d items from the oldest\n", (int) where);
+
+#ifdef CIRCBUF_STATS
+    /* Counters for sizing the buffer */
+    circbuf_stats_t stats;
+    circbuf_stats(&stats, cb);
+    printf("Buffer saw %d adds, %d removes, %d turned away, high water %d\n",
+           (int) stats.adds, (int) stats.removes, (int) stats.full, (int) stats.high_water);
+#endif
 
     /* Free the buffer */
     err = circbuf_destroy(cb);
@@ -80,6 +235,193 @@ int main() {
         printf("Could not destroy circular buffer.\n");
     }
 
+    /* Test overwrite mode, overfilling keeps only the newest items */
+    uint32_t newest[10];
+    uint32_t errors = 0;
+
+    err = circbuf_allocate_ex(10, CIRCBUF_OVERWRITE, &cb);
+    if (err == ERR_SUCCESS) {
+        for (uint32_t n = 0; n < 25; n++) {
+            circbuf_add(n, cb);
+        }
+        if (circbuf_size(cb) != 10 || circbuf_dropped(cb) != 15) {
+            errors++;
+        }
+        moved = circbuf_snapshot(newest, 10, cb);
+        if (moved != 10) {
+            errors++;
+        }
+        for (circbuf_count_t n = 0; n < moved; n++) {
+            if (newest[n] != 15u + n) {
+                errors++;
+            }
+        }
+        printf("Overwrite buffer kept %d of 25 items, dropped %d, snapshot of %d with %d errors\n",
+               (int) circbuf_size(cb), (int) circbuf_dropped(cb), (int) moved, errors);
+        circbuf_destroy(cb);
+    } else {
+        printf("Could not allocate overwrite buffer. Error code %d\n", err);
+    }
+
+#ifndef CIRCBUF_EMBEDDED
+    /* Test file backed buffer, it must come back after being closed */
+    const char *ring_path = "/tmp/homework1_demo.ring";
+    circbuf_t *view = NULL;
+    errors = 0;
+
+    remove(ring_path);
+    err = circbuf_map(ring_path, 16, 0, &cb);
+    if (err == ERR_SUCCESS) {
+        for (uint32_t n = 0; n < 10; n++) {
+            circbuf_add(n, cb);
+        }
+        circbuf_destroy(cb);
+
+        /* Map it again and pick up where it left off */
+        err = circbuf_map(ring_path, 16, 0, &cb);
+        if (err != ERR_SUCCESS || circbuf_size(cb) != 10) {
+            errors++;
+        }
+
+        /* A read only view sees the items but can not change them */
+        if (err == ERR_SUCCESS && circbuf_attach(ring_path, &view) == ERR_SUCCESS) {
+            if (circbuf_size(view) != 10 || circbuf_add(99, view) != ERR_CONFIG ||
+                circbuf_remove(&temp, view) != ERR_CONFIG) {
+                errors++;
+            }
+            circbuf_destroy(view);
+        } else {
+            errors++;
+        }
+
+        if (err == ERR_SUCCESS) {
+            for (uint32_t n = 0; n < 10; n++) {
+                if (circbuf_remove(&temp, cb) != ERR_SUCCESS || temp != n) {
+                    errors++;
+                }
+            }
+            circbuf_destroy(cb);
+        }
+        printf("File backed buffer resumed with %d errors\n", errors);
+        remove(ring_path);
+    } else {
+        printf("Could not map file backed buffer. Error code %d\n", err);
+    }
+#endif
+
+    /* Test typed buffer with 16 byte records */
+    circbuf_sample_t samples;
+    sample_t s = {0};
+
+    circbuf_sample_init(&samples);
+    for (uint32_t n = 0; n < 20; n++) {
+        s.id = n;
+        s.timestamp = 1000 * n;
+        circbuf_sample_add(s, &samples);
+    }
+    circbuf_sample_remove(&s, &samples);
+    printf("Typed buffer holds %d records, oldest id %d\n",
+           (int) circbuf_sample_size(&samples), s.id);
+
+    /* Test lock-free buffer with a second thread, order must be kept */
+    circbuf_spsc_t *ring = NULL;
+    pthread_t producer;
+    uint32_t expected = 0;
+
+    errors = 0;
+    err = circbuf_spsc_allocate(64, &ring);
+    if (err == ERR_SUCCESS) {
+        pthread_create(&producer, NULL, spsc_producer, ring);
+        while (expected < SPSC_ITEMS) {
+#ifdef CIRCBUF_HAVE_WAIT
+            err = circbuf_spsc_remove_wait(&temp, ring);
+#else
+            err = circbuf_spsc_remove(&temp, ring);
+            if (err != ERR_SUCCESS) {
+                sched_yield();
+            }
+#endif
+            if (err == ERR_SUCCESS) {
+                if (temp != expected) {
+                    errors++;
+                }
+                expected++;
+            }
+        }
+        pthread_join(producer, NULL);
+        printf("Lock-free buffer moved %d items with %d ordering errors\n",
+               SPSC_ITEMS, errors);
+#ifdef CIRCBUF_HAVE_WAIT
+        err = circbuf_spsc_remove_timed(&temp, 1000000, ring);
+        printf("Timed remove on empty buffer returned %d\n", err);
+#endif
+#ifdef CIRCBUF_STATS
+        circbuf_spsc_stats(&stats, ring);
+        printf("Lock-free buffer found full %d times, high water %d\n",
+               (int) stats.full, (int) stats.high_water);
+#endif
+        circbuf_spsc_destroy(ring);
+    } else {
+        printf("Could not allocate lock-free buffer. Error code %d\n", err);
+    }
+
+    /* Test multi producer, multi consumer buffer, every value exactly once */
+    static mpmc_demo_t demo;
+    pthread_t mpmc_threads[2 * MPMC_THREADS];
+    uint64_t total = (uint64_t) MPMC_THREADS * MPMC_ITEMS;
+
+    err = circbuf_mpmc_allocate(256, &demo.queue);
+    if (err == ERR_SUCCESS) {
+        for (int t = 0; t < MPMC_THREADS; t++) {
+            pthread_create(&mpmc_threads[t], NULL, mpmc_producer, &demo);
+            pthread_create(&mpmc_threads[MPMC_THREADS + t], NULL, mpmc_consumer, &demo);
+        }
+        for (int t = 0; t < 2 * MPMC_THREADS; t++) {
+            pthread_join(mpmc_threads[t], NULL);
+        }
+        errors = 0;
+        for (uint32_t n = 0; n < total; n++) {
+            if (atomic_load(&demo.seen[n]) != 1) {
+                errors++;
+            }
+        }
+        if (atomic_load(&demo.sum) != total * (total - 1) / 2) {
+            errors++;
+        }
+        printf("Multi producer buffer moved %d items on %d threads with %d errors\n",
+               (int) atomic_load(&demo.taken), 2 * MPMC_THREADS, errors);
+        circbuf_mpmc_destroy(demo.queue);
+    } else {
+        printf("Could not allocate multi producer buffer. Error code %d\n", err);
+    }
+
+#ifdef CIRCBUF_HAVE_SHM
+    /* Test shared memory channel, messages of every length wrap the ring */
+    circbuf_shm_t *channel = NULL;
+    char msg[64];
+    char got[64];
+    size_t len;
+
+    err = circbuf_shm_create("/homework1_demo", 256, 0, &channel);
+    if (err == ERR_SUCCESS) {
+        circbuf_shm_unlink("/homework1_demo");
+        errors = 0;
+        for (int n = 0; n < 1000; n++) {
+            len = (size_t) (n % 60);
+            snprintf(msg, sizeof(msg), "%059d", n);
+            if (circbuf_shm_send(channel, msg, len) != ERR_SUCCESS ||
+                circbuf_shm_recv(channel, got, sizeof(got), &len) != ERR_SUCCESS ||
+                len != (size_t) (n % 60) || memcmp(msg, got, len) != 0) {
+                errors++;
+            }
+        }
+        printf("Shared memory channel moved 1000 messages with %d errors\n", errors);
+        circbuf_shm_close(channel);
+    } else {
+        printf("Could not create shared memory channel. Error code %d\n", err);
+    }
+#endif
+
     /* Test doubly linked list */
     ll2_node_t *head = NULL;
     ll2_err_t e;
@@ -120,5 +462,169 @@ int main() {
         printf("Did not destroy list\n");
     }
 
+    /* Test batch insert and range remove, each walks once */
+    uint32_t batch[8] = { 10, 11, 12, 13, 14, 15, 16, 17 };
+    e = ll2_insert_array(&head, batch, 8, 0);
+    e = ll2_insert_array(&head, batch, 4, 4);
+    e = ll2_remove_range(&head, 2, 6);
+    printf("Batch list holds %d nodes\n", ll2_size(&head));
+    e = ll2_destroy(&head);
+
+    /* Test pooled list, nodes come from a fixed arena */
+    static ll2_node_t arena[32];
+    ll2_pool_t pool;
+
+    ll2_pool_init(&pool, arena, sizeof(arena));
+    for (int n = 0; n < 1000; n++) {
+        e = ll2_add_node_pool(&head, n, 0, &pool);
+        if (ll2_size(&head) > 16) {
+            e = ll2_remove_node_pool(&head, 16, &pool);
+        }
+    }
+    printf("Pooled list holds %d nodes, ", ll2_size(&head));
+    e = ll2_destroy_pool(&head, &pool);
+    printf("%d after destroy\n", ll2_size(&head));
+    ll2_pool_destroy(&pool);
+
+    /* Test list handle, appends do not walk the list */
+    ll2_list_t list;
+    uint32_t last = 0;
+
+    ll2_list_init(&list, NULL);
+    for (uint32_t n = 0; n < 100000; n++) {
+        e = ll2_list_push_back(&list, n);
+    }
+    e = ll2_list_pop_back(&list, &last);
+    printf("List handle holds %zu nodes, popped %u\n", ll2_list_size(&list), last);
+
+    /* Index the values, lookups no longer walk the list */
+    size_t position = 0;
+    e = ll2_list_index_enable(&list);
+    e = ll2_list_search(&list, 99990, &position);
+    printf("Indexed search found 99990 at index %zu\n", position);
+    e = ll2_list_index_disable(&list);
+
+    /* Edit the list in one pass, drop odd values and repeat multiples of 10 */
+    ll2_cursor_t cursor;
+    uint32_t value;
+
+    e = ll2_list_cursor_init(&cursor, &list, 0);
+    while (ll2_cursor_get(&cursor, &value) == LL2_SUCCESS) {
+        if (value % 2 != 0) {
+            e = ll2_cursor_remove(&cursor);
+            continue;
+        }
+        if (value % 10 == 0) {
+            e = ll2_cursor_insert_before(&cursor, value);
+        }
+        e = ll2_cursor_next(&cursor);
+    }
+    printf("Cursor pass left %zu nodes\n", ll2_list_size(&list));
+    e = ll2_list_destroy(&list);
+
+    /* Test unrolled list, blocks split and merge out of sight */
+    ll2u_list_t unrolled;
+    size_t found = 0;
+
+    ll2u_init(&unrolled);
+    for (uint32_t n = 0; n < 1000; n++) {
+        e = ll2u_add(&unrolled, n, n / 2);
+    }
+    for (uint32_t n = 0; n < 500; n++) {
+        e = ll2u_remove(&unrolled, 0);
+    }
+    e = ll2u_search(&unrolled, 0, &found);
+    printf("Unrolled list holds %zu values, 0 found at index %zu\n",
+           ll2u_size(&unrolled), found);
+    e = ll2u_destroy(&unrolled);
+
+    /* Test skip list, every add lands in the middle */
+    ll2s_list_t skip;
+    uint32_t middle = 0;
+
+    ll2s_init(&skip);
+    for (uint32_t n = 0; n < 10000; n++) {
+        e = ll2s_add(&skip, n, ll2s_size(&skip) / 2);
+    }
+    e = ll2s_remove(&skip, 0);
+    e = ll2s_get(&skip, ll2s_size(&skip) / 2, &middle);
+    printf("Skip list holds %zu values, %u in the middle\n",
+           ll2s_size(&skip), middle);
+    e = ll2s_destroy(&skip);
+
+    /* Test compact list, a copy is one memcpy of the node array */
+    ll2a_list_t compact;
+    ll2a_list_t copy;
+
+    ll2a_init(&compact, 0);
+    for (uint32_t n = 0; n < 1000; n++) {
+        e = ll2a_add(&compact, n, ll2a_size(&compact) / 2);
+    }
+    e = ll2a_remove(&compact, 0);
+    e = ll2a_copy(&copy, &compact);
+    e = ll2a_search(&copy, 0, &found);
+    printf("Compact list copy holds %zu values in %zu byte nodes, 0 found at index %zu\n",
+           ll2a_size(&copy), sizeof(ll2a_node_t), found);
+    e = ll2a_destroy(&copy);
+    e = ll2a_destroy(&compact);
+
+    /* Test sorting, then merge in a list that was kept sorted */
+    ll2_list_t ordered;
+    ll2_list_t extra;
+
+    ll2_list_init(&ordered, NULL);
+    ll2_list_init(&extra, NULL);
+    for (uint32_t n = 0; n < 1000; n++) {
+        e = ll2_list_push_back(&ordered, (n * 7919) % 1000);
+        e = ll2_list_add_sorted(&extra, (n * 104729) % 1000);
+    }
+    e = ll2_list_sort(&ordered);
+    e = ll2_list_merge(&ordered, &extra);
+    printf("Merged list holds %zu values from %u to %u\n",
+           ll2_list_size(&ordered), ordered.head->data, ordered.tail->data);
+    e = ll2_list_destroy(&ordered);
+
+    /* Test intrusive list as a run queue, tasks move without allocating */
+    struct task {
+        uint32_t id;
+        ll2i_link_t link;
+    } tasks[8];
+    ll2i_list_t ready;
+    ll2i_list_t blocked;
+    ll2i_link_t *link;
+
+    ll2i_init(&ready);
+    ll2i_init(&blocked);
+    for (uint32_t n = 0; n < 8; n++) {
+        tasks[n].id = n;
+        ll2i_link_init(&tasks[n].link);
+        e = ll2i_push_back(&ready, &tasks[n].link);
+    }
+    for (uint32_t n = 0; n < 8; n += 3) {
+        e = ll2i_move(&blocked, &ready, &tasks[n].link);
+    }
+    link = ll2i_pop_front(&ready);
+    printf("Run queue picked task %u, %zu ready and %zu blocked\n",
+           LL2I_CONTAINER(link, struct task, link)->id, ll2i_size(&ready), ll2i_size(&blocked));
+
+    /* Test concurrent list, two writers while this thread searches */
+    static ll2c_list_t shared;
+    pthread_t writers[2];
+    ll2c_thread_t *self;
+
+    ll2c_init(&shared);
+    self = ll2c_thread_register(&shared);
+    pthread_create(&writers[0], NULL, ll2c_writer, &shared);
+    pthread_create(&writers[1], NULL, ll2c_writer, &shared);
+    while (ll2c_search(&shared, self, 499, &found) != LL2_SUCCESS) {
+        sched_yield();
+    }
+    pthread_join(writers[0], NULL);
+    pthread_join(writers[1], NULL);
+    e = ll2c_remove(&shared, self, 0);
+    printf("Concurrent list holds %zu values after two writers\n", ll2c_size(&shared));
+    ll2c_thread_unregister(self);
+    e = ll2c_destroy(&shared);
+
     return 0;
 }
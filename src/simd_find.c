@@ -0,0 +1,272 @@
+/**********************************************************
+* Name: simd_find.c
+*
+* Date: 10/17/2026
+*
+* Author: Ben Heberlein
+*
+* Description: This file implements equality and range
+* search over uint32_t runs with AVX2, SSE2 and scalar
+* kernels, and picks one the first time it is called.
+*
+**********************************************************/
+
+#include <stdint.h>
+#include <stdatomic.h>
+#include "simd_find.h"
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define SIMD_FIND_X86
+#include <immintrin.h>
+#endif
+
+/**********************************************************
+* Kernel levels, SIMD_UNKNOWN until the first call has
+* asked the CPU what it supports.
+**********************************************************/
+enum {SIMD_UNKNOWN=-1, SIMD_SCALAR=0, SIMD_SSE2, SIMD_AVX2};
+
+static _Atomic int simd_level = SIMD_UNKNOWN;
+
+/**********************************************************
+* The range kernels test (x - lo) <= (hi - lo) as unsigned
+* numbers. SSE2 and AVX2 only have a signed compare, so
+* both sides get their top bit flipped first.
+**********************************************************/
+#define SIMD_SIGN 0x80000000u
+
+static size_t simd_find_eq_scalar(const uint32_t *data, size_t count, uint32_t value) {
+    for (size_t i = 0; i < count; i++) {
+        if (data[i] == value) {
+            return i;
+        }
+    }
+    return count;
+}
+
+static size_t simd_find_range_scalar(const uint32_t *data, size_t count, uint32_t lo, uint32_t span) {
+    for (size_t i = 0; i < count; i++) {
+        if (data[i] - lo <= span) {
+            return i;
+        }
+    }
+    return count;
+}
+
+#ifdef SIMD_FIND_X86
+__attribute__((target("sse2")))
+static inline uint32_t simd_mask_sse2(__m128i v) {
+    return (uint32_t) _mm_movemask_ps(_mm_castsi128_ps(v));
+}
+
+__attribute__((target("sse2")))
+static size_t simd_find_eq_sse2(const uint32_t *data, size_t count, uint32_t value) {
+    const __m128i key = _mm_set1_epi32((int) value);
+    size_t i = 0;
+
+    // Four vectors per round, one branch for all sixteen items
+    for (; i + 16 <= count; i += 16) {
+        const __m128i *p = (const __m128i *) (data + i);
+        uint32_t m = simd_mask_sse2(_mm_cmpeq_epi32(_mm_loadu_si128(p), key)) |
+                     simd_mask_sse2(_mm_cmpeq_epi32(_mm_loadu_si128(p + 1), key)) << 4 |
+                     simd_mask_sse2(_mm_cmpeq_epi32(_mm_loadu_si128(p + 2), key)) << 8 |
+                     simd_mask_sse2(_mm_cmpeq_epi32(_mm_loadu_si128(p + 3), key)) << 12;
+        if (m) {
+            return i + (size_t) __builtin_ctz(m);
+        }
+    }
+    for (; i + 4 <= count; i += 4) {
+        uint32_t m = simd_mask_sse2(_mm_cmpeq_epi32(_mm_loadu_si128((const __m128i *) (data + i)), key));
+        if (m) {
+            return i + (size_t) __builtin_ctz(m);
+        }
+    }
+
+    return i + simd_find_eq_scalar(data + i, count - i, value);
+}
+
+__attribute__((target("sse2")))
+static size_t simd_find_range_sse2(const uint32_t *data, size_t count, uint32_t lo, uint32_t span) {
+    const __m128i base = _mm_set1_epi32((int) (lo + SIMD_SIGN));
+    const __m128i limit = _mm_set1_epi32((int) (span ^ SIMD_SIGN));
+    size_t i = 0;
+
+    // x - (lo + sign) is (x - lo) with the top bit flipped, a set mask bit is a miss
+    for (; i + 16 <= count; i += 16) {
+        const __m128i *p = (const __m128i *) (data + i);
+        uint32_t m = simd_mask_sse2(_mm_cmpgt_epi32(_mm_sub_epi32(_mm_loadu_si128(p), base), limit)) |
+                     simd_mask_sse2(_mm_cmpgt_epi32(_mm_sub_epi32(_mm_loadu_si128(p + 1), base), limit)) << 4 |
+                     simd_mask_sse2(_mm_cmpgt_epi32(_mm_sub_epi32(_mm_loadu_si128(p + 2), base), limit)) << 8 |
+                     simd_mask_sse2(_mm_cmpgt_epi32(_mm_sub_epi32(_mm_loadu_si128(p + 3), base), limit)) << 12;
+        m = ~m & 0xffffu;
+        if (m) {
+            return i + (size_t) __builtin_ctz(m);
+        }
+    }
+    for (; i + 4 <= count; i += 4) {
+        __m128i x = _mm_sub_epi32(_mm_loadu_si128((const __m128i *) (data + i)), base);
+        uint32_t m = ~simd_mask_sse2(_mm_cmpgt_epi32(x, limit)) & 0xfu;
+        if (m) {
+            return i + (size_t) __builtin_ctz(m);
+        }
+    }
+
+    return i + simd_find_range_scalar(data + i, count - i, lo, span);
+}
+
+__attribute__((target("avx2")))
+static inline uint32_t simd_mask_avx2(__m256i v) {
+    return (uint32_t) _mm256_movemask_ps(_mm256_castsi256_ps(v));
+}
+
+__attribute__((target("avx2")))
+static size_t simd_find_eq_avx2(const uint32_t *data, size_t count, uint32_t value) {
+    const __m256i key = _mm256_set1_epi32((int) value);
+    size_t i = 0;
+
+    for (; i + 32 <= count; i += 32) {
+        const __m256i *p = (const __m256i *) (data + i);
+        uint32_t m = simd_mask_avx2(_mm256_cmpeq_epi32(_mm256_loadu_si256(p), key)) |
+                     simd_mask_avx2(_mm256_cmpeq_epi32(_mm256_loadu_si256(p + 1), key)) << 8 |
+                     simd_mask_avx2(_mm256_cmpeq_epi32(_mm256_loadu_si256(p + 2), key)) << 16 |
+                     simd_mask_avx2(_mm256_cmpeq_epi32(_mm256_loadu_si256(p + 3), key)) << 24;
+        if (m) {
+            return i + (size_t) __builtin_ctz(m);
+        }
+    }
+    for (; i + 8 <= count; i += 8) {
+        uint32_t m = simd_mask_avx2(_mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i *) (data + i)), key));
+        if (m) {
+            return i + (size_t) __builtin_ctz(m);
+        }
+    }
+
+    return i + simd_find_eq_scalar(data + i, count - i, value);
+}
+
+__attribute__((target("avx2")))
+static size_t simd_find_range_avx2(const uint32_t *data, size_t count, uint32_t lo, uint32_t span) {
+    const __m256i base = _mm256_set1_epi32((int) (lo + SIMD_SIGN));
+    const __m256i limit = _mm256_set1_epi32((int) (span ^ SIMD_SIGN));
+    size_t i = 0;
+
+    for (; i + 32 <= count; i += 32) {
+        const __m256i *p = (const __m256i *) (data + i);
+        uint32_t m = simd_mask_avx2(_mm256_cmpgt_epi32(_mm256_sub_epi32(_mm256_loadu_si256(p), base), limit)) |
+                     simd_mask_avx2(_mm256_cmpgt_epi32(_mm256_sub_epi32(_mm256_loadu_si256(p + 1), base), limit)) << 8 |
+                     simd_mask_avx2(_mm256_cmpgt_epi32(_mm256_sub_epi32(_mm256_loadu_si256(p + 2), base), limit)) << 16 |
+                     simd_mask_avx2(_mm256_cmpgt_epi32(_mm256_sub_epi32(_mm256_loadu_si256(p + 3), base), limit)) << 24;
+        m = ~m;
+        if (m) {
+            return i + (size_t) __builtin_ctz(m);
+        }
+    }
+    for (; i + 8 <= count; i += 8) {
+        __m256i x = _mm256_sub_epi32(_mm256_loadu_si256((const __m256i *) (data + i)), base);
+        uint32_t m = ~simd_mask_avx2(_mm256_cmpgt_epi32(x, limit)) & 0xffu;
+        if (m) {
+            return i + (size_t) __builtin_ctz(m);
+        }
+    }
+
+    return i + simd_find_range_scalar(data + i, count - i, lo, span);
+}
+#endif
+
+/***********************************************************
+* simd_find_level    : static int simd_find_level(void);
+*   returns          : The kernel level to use on this CPU
+* Description        : Ask CPUID once and remember the answer. Racing
+*                      callers all store the same value.
+***********************************************************/
+static int simd_find_level(void) {
+    int level = atomic_load_explicit(&simd_level, memory_order_relaxed);
+    if (level != SIMD_UNKNOWN) {
+        return level;
+    }
+
+    level = SIMD_SCALAR;
+#ifdef SIMD_FIND_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        level = SIMD_AVX2;
+    } else if (__builtin_cpu_supports("sse2")) {
+        level = SIMD_SSE2;
+    }
+#endif
+    atomic_store_explicit(&simd_level, level, memory_order_relaxed);
+    return level;
+}
+
+/***********************************************************
+* simd_find_eq      : size_t simd_find_eq(const uint32_t *data, size_t count, uint32_t value);
+*   returns         : Index of the first item equal to value, or count if none
+*   data            : Start of the run
+*   count           : Number of items in the run
+*   value           : Value to look for
+* Author            : Ben Heberlein
+* Date              : 10/17/2026
+* Description       : Find the first item equal to a value
+***********************************************************/
+size_t simd_find_eq(const uint32_t *data, size_t count, uint32_t value) {
+    if (data == NULL) {
+        return count;
+    }
+
+    switch (simd_find_level()) {
+#ifdef SIMD_FIND_X86
+    case SIMD_AVX2:
+        return simd_find_eq_avx2(data, count, value);
+    case SIMD_SSE2:
+        return simd_find_eq_sse2(data, count, value);
+#endif
+    default:
+        return simd_find_eq_scalar(data, count, value);
+    }
+}
+
+/***********************************************************
+* simd_find_range   : size_t simd_find_range(const uint32_t *data, size_t count, uint32_t lo, uint32_t hi);
+*   returns         : Index of the first item in [lo, hi], or count if none
+*   data            : Start of the run
+*   count           : Number of items in the run
+*   lo              : Smallest value that matches
+*   hi              : Largest value that matches, an empty range if below lo
+* Author            : Ben Heberlein
+* Date              : 10/17/2026
+* Description       : Find the first item inside an inclusive range
+***********************************************************/
+size_t simd_find_range(const uint32_t *data, size_t count, uint32_t lo, uint32_t hi) {
+    if (data == NULL || hi < lo) {
+        return count;
+    }
+
+    switch (simd_find_level()) {
+#ifdef SIMD_FIND_X86
+    case SIMD_AVX2:
+        return simd_find_range_avx2(data, count, lo, hi - lo);
+    case SIMD_SSE2:
+        return simd_find_range_sse2(data, count, lo, hi - lo);
+#endif
+    default:
+        return simd_find_range_scalar(data, count, lo, hi - lo);
+    }
+}
+
+/***********************************************************
+* simd_find_impl    : const char *simd_find_impl(void);
+*   returns         : "avx2", "sse2" or "scalar"
+* Author            : Ben Heberlein
+* Date              : 10/17/2026
+* Description       : Name the kernels picked for this CPU
+***********************************************************/
+const char *simd_find_impl(void) {
+    switch (simd_find_level()) {
+    case SIMD_AVX2:
+        return "avx2";
+    case SIMD_SSE2:
+        return "sse2";
+    default:
+        return "scalar";
+    }
+}